@@ -0,0 +1,671 @@
+/**
+ * prvhash_bench.cpp version 4.3.0
+ *
+ * Benchmark program for the PRVHASH hash functions, the TANGO642 cipher, the
+ * "prvrng" and Gradilac PRNGs, and the PrvHashMap hash map. Measures
+ * small-message latency (1 to 256 bytes), bulk throughput (4 KiB to 16 MiB,
+ * or to 1 GiB with the "-large" option), and hash map insertion and lookup
+ * times (compared to std::unordered_map), and prints results in the JSON
+ * format. Only tests whose name includes the specified substring are run, if
+ * it is specified.
+ *
+ * Usage: prvhash_bench [-large] [name]
+ *
+ * Compilation (from the "bench" directory):
+ *
+ * g++ -O3 -march=native -std=c++17 -I.. prvhash_bench.cpp -o prvhash_bench
+ *
+ * On x86, times are measured in TSC ticks, which equal processor's cycles
+ * only if the processor runs at its nominal frequency: so, frequency scaling
+ * and "turbo" modes should be disabled for reproducible results. On other
+ * processors, nanoseconds are reported instead. Each measurement is the best
+ * of several runs.
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "prvhash64.h"
+#include "prvhash128.h"
+#include "prvhash16.h"
+#include "prvhash64s.h"
+#include "prvhash64sx.h"
+#include "tango642.h"
+#include "prvrng.h"
+#include "gradilac.h"
+#include "prvhash_map.h"
+
+#if defined( __i386__ ) || defined( __x86_64__ ) || defined( _M_IX86 ) || \
+	defined( _M_X64 )
+
+	#if defined( _MSC_VER )
+		#include <intrin.h>
+	#else // defined( _MSC_VER )
+		#include <x86intrin.h>
+	#endif // defined( _MSC_VER )
+
+	#define BENCH_TSC 1
+	#define BENCH_UNIT "ticks"
+
+#else // defined( __i386__ )
+
+	#define BENCH_UNIT "ns"
+
+#endif // defined( __i386__ )
+
+#define BENCH_RUNS 7 // The number of runs, the best one is reported.
+#define BENCH_BULK_MAX ( (size_t) 1 << 24 ) // Default maximal bulk length.
+#define BENCH_BULK_LARGE ( (size_t) 1 << 30 ) // "-large" maximal bulk length.
+#define BENCH_BULK_SUM ( (size_t) 1 << 26 ) // Bytes processed in a run.
+#define BENCH_LAT_CALLS 20000 // The number of calls in a latency run.
+#define BENCH_MAP_MAX ( (size_t) 1 << 20 ) // Maximal number of map elements.
+
+static const char* Filter = 0; // Test name filter, 0 - run all tests.
+static int ResCount = 0; // The number of printed results.
+static volatile uint64_t Sink; // Receives results, to avoid their removal.
+
+/**
+ * @return Current time, in BENCH_UNIT units.
+ */
+
+static inline uint64_t bench_time()
+{
+	#if defined( BENCH_TSC )
+
+		return( (uint64_t) __rdtsc() );
+
+	#else // defined( BENCH_TSC )
+
+		return( (uint64_t) std::chrono :: duration_cast<
+			std :: chrono :: nanoseconds >( std :: chrono :: steady_clock ::
+			now().time_since_epoch() ).count() );
+
+	#endif // defined( BENCH_TSC )
+}
+
+/**
+ * @return 1 if the test with the specified name should be run.
+ */
+
+static bool bench_use( const char* const name )
+{
+	return( Filter == 0 || strstr( name, Filter ) != 0 );
+}
+
+/**
+ * Function prints a single JSON result record.
+ *
+ * @param name Test's name.
+ * @param kind Measurement kind, "latency", "throughput" or "map".
+ * @param len Message or buffer length, in bytes; the number of elements for
+ * "map".
+ * @param t Best time per call ("latency") or per byte ("throughput"), in
+ * BENCH_UNIT units.
+ * @param gbps Throughput, in GB/s, or 0 for "latency".
+ */
+
+static void bench_print( const char* const name, const char* const kind,
+	const size_t len, const double t, const double gbps )
+{
+	printf( "%s\n    { \"name\": \"%s\", \"kind\": \"%s\", \"len\": %zu, ",
+		( ResCount > 0 ? "," : "" ), name, kind, len );
+
+	if( gbps > 0.0 )
+	{
+		printf( "\"" BENCH_UNIT "_per_byte\": %.4f, \"gbps\": %.3f }", t,
+			gbps );
+	}
+	else
+	{
+		printf( "\"" BENCH_UNIT "_per_call\": %.2f }", t );
+	}
+
+	ResCount++;
+	fflush( stdout );
+}
+
+/**
+ * Function measures the latency of a function on short messages of the
+ * specified lengths. Each call uses a message that depends on the previous
+ * call's result, so that calls are not overlapped by the processor.
+ *
+ * @param name Test's name.
+ * @param fn Function, "uint64_t fn( uint8_t* msg, size_t len )".
+ * @param Lens Message lengths, in bytes, each <= 256.
+ * @param LenCount The number of message lengths.
+ */
+
+template< typename ftype >
+static void bench_latency( const char* const name, ftype fn,
+	const size_t* const Lens, const size_t LenCount )
+{
+	if( !bench_use( name ))
+	{
+		return;
+	}
+
+	uint8_t msg[ 256 ];
+	size_t i;
+
+	for( i = 0; i < sizeof( msg ); i++ )
+	{
+		msg[ i ] = (uint8_t) ( i * 0x9B + 1 );
+	}
+
+	for( i = 0; i < LenCount; i++ )
+	{
+		const size_t l = Lens[ i ];
+		uint64_t best = ~(uint64_t) 0;
+		uint64_t h = 0;
+		int r;
+
+		for( r = 0; r < BENCH_RUNS; r++ )
+		{
+			const uint64_t t0 = bench_time();
+			int k;
+
+			for( k = 0; k < BENCH_LAT_CALLS; k++ )
+			{
+				msg[ 0 ] ^= (uint8_t) h;
+				h = fn( msg, l );
+			}
+
+			const uint64_t t = bench_time() - t0;
+			best = ( t < best ? t : best );
+		}
+
+		Sink += h;
+		bench_print( name, "latency", l, (double) best / BENCH_LAT_CALLS, 0 );
+	}
+}
+
+/**
+ * Function measures the latency of a function on short messages, of 1 to
+ * 256 bytes.
+ *
+ * @param name Test's name.
+ * @param fn Function, "uint64_t fn( uint8_t* msg, size_t len )".
+ */
+
+template< typename ftype >
+static void bench_latency( const char* const name, ftype fn )
+{
+	static const size_t Lens[] = { 1, 2, 3, 4, 7, 8, 15, 16, 31, 32, 64,
+		128, 256 };
+
+	bench_latency( name, fn, Lens, sizeof( Lens ) / sizeof( Lens[ 0 ]));
+}
+
+/**
+ * Function measures the throughput of a function on large buffers.
+ *
+ * @param name Test's name.
+ * @param buf Buffer, at least MaxLen bytes.
+ * @param MaxLen Maximal buffer length.
+ * @param fn Function, "uint64_t fn( uint8_t* buf, size_t len )".
+ */
+
+template< typename ftype >
+static void bench_bulk( const char* const name, uint8_t* const buf,
+	const size_t MaxLen, ftype fn )
+{
+	if( !bench_use( name ))
+	{
+		return;
+	}
+
+	size_t l;
+
+	for( l = 4096; l <= MaxLen; l *= 16 )
+	{
+		const size_t calls = ( l < BENCH_BULK_SUM ? BENCH_BULK_SUM / l : 1 );
+		const int runs = ( l < BENCH_BULK_SUM ? BENCH_RUNS : 3 );
+		uint64_t best = ~(uint64_t) 0;
+		double bestns = 0.0;
+		int r;
+
+		for( r = 0; r < runs; r++ )
+		{
+			const auto c0 = std :: chrono :: steady_clock :: now();
+			const uint64_t t0 = bench_time();
+			size_t k;
+
+			for( k = 0; k < calls; k++ )
+			{
+				Sink += fn( buf, l );
+			}
+
+			const uint64_t t = bench_time() - t0;
+
+			if( t < best )
+			{
+				best = t;
+				bestns = (double) std :: chrono :: duration_cast<
+					std :: chrono :: nanoseconds >(
+					std :: chrono :: steady_clock :: now() - c0 ).count();
+			}
+		}
+
+		const double total = (double) l * calls;
+
+		bench_print( name, "throughput", l, (double) best / total,
+			( bestns > 0.0 ? total / bestns : 0.0 ));
+
+		if( l == ( (size_t) 1 << 24 ) && MaxLen > l )
+		{
+			l = MaxLen / 16; // Jump to MaxLen.
+		}
+	}
+}
+
+/**
+ * Function measures the throughput of a PRNG's byte output.
+ *
+ * @param name Test's name.
+ * @param buf Buffer, at least BENCH_BULK_MAX bytes.
+ * @param fn Function, "uint64_t fn( uint8_t* buf, size_t len )", which
+ * fills the buffer with random bytes.
+ */
+
+template< typename ftype >
+static void bench_prng( const char* const name, uint8_t* const buf,
+	ftype fn )
+{
+	bench_bulk( name, buf, (size_t) 1 << 20, fn );
+}
+
+/**
+ * Hasher for std::unordered_map, which uses the "prvhash64_64m" hash
+ * function, for comparison with PrvHashMap under equal hashing costs.
+ */
+
+struct BenchStdHasher
+{
+	size_t operator()( const uint64_t k ) const
+	{
+		return( (size_t) prvhash64_64m( &k, sizeof( k ), 0 ));
+	}
+
+	size_t operator()( const std :: string& k ) const
+	{
+		return( (size_t) prvhash64_64m( k.data(), k.size(), 0 ));
+	}
+};
+
+/**
+ * Function measures the average time of a hash map insertion (into an
+ * initially empty map), and of a successful lookup (in random order), for
+ * several numbers of elements.
+ *
+ * @param name Test's name, "::insert" and "::find" suffixes are added.
+ * @param Keys Unique keys, BENCH_MAP_MAX items.
+ * @tparam mtype Map type, with key type "ktype" and mapped type "size_t".
+ * @tparam ktype Key type.
+ */
+
+template< typename mtype, typename ktype >
+static void bench_map( const char* const name, const ktype* const Keys )
+{
+	const std :: string ni = std :: string( name ) + "::insert";
+	const std :: string nf = std :: string( name ) + "::find";
+
+	if( !bench_use( ni.c_str() ) && !bench_use( nf.c_str() ))
+	{
+		return;
+	}
+
+	size_t n;
+
+	for( n = 1024; n <= BENCH_MAP_MAX; n *= 32 )
+	{
+		std :: vector< ktype > Look( Keys, Keys + n );
+		uint64_t rv = 1;
+		size_t i;
+
+		for( i = n - 1; i > 0; i-- )
+		{
+			rv = rv * 6364136223846793005 + 1442695040888963407;
+			std :: swap( Look[ i ], Look[ ( rv >> 32 ) % ( i + 1 )]);
+		}
+
+		const int runs = ( n < BENCH_MAP_MAX ? BENCH_RUNS : 3 );
+		uint64_t bi = ~(uint64_t) 0;
+		uint64_t bf = ~(uint64_t) 0;
+		int r;
+
+		for( r = 0; r < runs; r++ )
+		{
+			mtype m;
+			uint64_t t0 = bench_time();
+
+			for( i = 0; i < n; i++ )
+			{
+				m[ Keys[ i ]] = i;
+			}
+
+			uint64_t t = bench_time() - t0;
+			bi = ( t < bi ? t : bi );
+
+			size_t sum = 0;
+			t0 = bench_time();
+
+			for( i = 0; i < n; i++ )
+			{
+				sum += m.find( Look[ i ]) -> second;
+			}
+
+			t = bench_time() - t0;
+			bf = ( t < bf ? t : bf );
+			Sink += sum;
+		}
+
+		if( bench_use( ni.c_str() ))
+		{
+			bench_print( ni.c_str(), "map", n, (double) bi / n, 0 );
+		}
+
+		if( bench_use( nf.c_str() ))
+		{
+			bench_print( nf.c_str(), "map", n, (double) bf / n, 0 );
+		}
+	}
+}
+
+int main( int argc, char** argv )
+{
+	size_t MaxLen = BENCH_BULK_MAX;
+	int i;
+
+	for( i = 1; i < argc; i++ )
+	{
+		if( strcmp( argv[ i ], "-large" ) == 0 )
+		{
+			MaxLen = BENCH_BULK_LARGE;
+		}
+		else
+		{
+			Filter = argv[ i ];
+		}
+	}
+
+	uint8_t* const buf = (uint8_t*) malloc( MaxLen );
+
+	if( buf == 0 )
+	{
+		fprintf( stderr, "prvhash_bench: out of memory\n" );
+		return( 1 );
+	}
+
+	size_t k;
+
+	for( k = 0; k < MaxLen; k++ )
+	{
+		buf[ k ] = (uint8_t) ( k * 0x9B + ( k >> 11 ));
+	}
+
+	printf( "{\n  \"unit\": \"%s\",\n", BENCH_UNIT );
+
+	#if defined( __clang__ )
+		printf( "  \"compiler\": \"clang %s\",\n", __clang_version__ );
+	#elif defined( __GNUC__ )
+		printf( "  \"compiler\": \"gcc %s\",\n", __VERSION__ );
+	#elif defined( _MSC_VER )
+		printf( "  \"compiler\": \"msvc %i\",\n", (int) _MSC_VER );
+	#else // defined( _MSC_VER )
+		printf( "  \"compiler\": \"unknown\",\n" );
+	#endif // defined( _MSC_VER )
+
+	printf( "  \"results\": [" );
+
+	// Hash functions.
+
+	bench_latency( "prvhash64_64m", []( uint8_t* m, size_t l )
+		{ return( prvhash64_64m( m, l, 0 )); });
+
+	bench_latency( "prvhash64_64m-x2", []( uint8_t* m, size_t l )
+		{ return( prvhash64_64m( m, l, 0 ) ^ prvhash64_64m( m, l, 1 )); });
+
+	#if defined( __SIZEOF_INT128__ )
+
+	bench_latency( "prvhash128_128m", []( uint8_t* m, size_t l )
+		{ const PRH128_T h = prvhash128_128m( m, l, 0 );
+		return( (uint64_t) h ^ (uint64_t) ( h >> 64 )); });
+
+	#endif // defined( __SIZEOF_INT128__ )
+
+	bench_latency( "prvhash64_64mk-8", []( uint8_t* m, size_t l )
+		{ uint64_t h[ 8 ]; prvhash64_64mk( m, l, 0, h, 8 ); return( h[ 7 ]); });
+
+	bench_latency( "prvhash64-64", []( uint8_t* m, size_t l )
+		{ uint64_t h; prvhash64( m, l, &h, 8, 0 ); return( h ); });
+
+	bench_latency( "prvhash16-32", []( uint8_t* m, size_t l )
+		{ uint32_t h; prvhash16( m, l, &h, 4, 0 ); return( (uint64_t) h ); });
+
+	bench_latency( "prvhash64-1024", []( uint8_t* m, size_t l )
+		{ uint64_t h[ 16 ]; prvhash64( m, l, h, 128, 0 ); return( h[ 0 ]); });
+
+	bench_latency( "prvhash64s-64", []( uint8_t* m, size_t l )
+		{ uint64_t h; prvhash64s_oneshot( m, l, &h, 8 ); return( h ); });
+
+	bench_bulk( "prvhash64_64m", buf, MaxLen, []( uint8_t* m, size_t l )
+		{ return( prvhash64_64m( m, l, 0 )); });
+
+	bench_bulk( "prvhash64-64", buf, MaxLen, []( uint8_t* m, size_t l )
+		{ uint64_t h; prvhash64( m, l, &h, 8, 0 ); return( h ); });
+
+	bench_bulk( "prvhash16-32", buf, MaxLen, []( uint8_t* m, size_t l )
+		{ uint32_t h; prvhash16( m, l, &h, 4, 0 ); return( (uint64_t) h ); });
+
+	bench_bulk( "prvhash64s-256", buf, MaxLen, []( uint8_t* m, size_t l )
+		{
+			uint64_t h[ 4 ];
+			prvhash64s_oneshot( m, l, h, sizeof( h ));
+			return( h[ 0 ]);
+		});
+
+	bench_bulk( "prvhash64s8-256", buf, MaxLen, []( uint8_t* m, size_t l )
+		{
+			uint64_t h[ 4 ];
+			prvhash64s8_oneshot( m, l, h, sizeof( h ));
+			return( h[ 0 ]);
+		});
+
+	bench_bulk( "prvhash64s16-256", buf, MaxLen, []( uint8_t* m, size_t l )
+		{
+			uint64_t h[ 4 ];
+			prvhash64s16_oneshot( m, l, h, sizeof( h ));
+			return( h[ 0 ]);
+		});
+
+	// Cipher.
+
+	static TANGO642_CTX kt;
+	static TANGO642_CTX tc;
+	const uint8_t key[ 32 ] = { 1, 2, 3 };
+	const uint8_t iv[ 16 ] = { 4, 5, 6 };
+	tango642_init_key( &kt, key, sizeof( key ));
+
+	// tango642_init_iv() accepts "iv" lengths in increments of 8, up to 64.
+
+	static const size_t IvLens[] = { 8, 16, 24, 32, 40, 48, 56, 64 };
+
+	bench_latency( "tango642_init_iv", []( uint8_t* m, size_t l )
+		{ tango642_init_iv( &tc, &kt, m, l ); return( tc.Hash[ 0 ]); },
+		IvLens, sizeof( IvLens ) / sizeof( IvLens[ 0 ]));
+
+	tango642_init_iv( &tc, &kt, iv, sizeof( iv ));
+
+	bench_latency( "tango642_xor", []( uint8_t* m, size_t l )
+		{ tango642_xor( &tc, m, l ); return( (uint64_t) m[ l - 1 ]); });
+
+	bench_bulk( "tango642_xor", buf, MaxLen, []( uint8_t* m, size_t l )
+		{ tango642_xor( &tc, m, l ); return( (uint64_t) m[ l - 1 ]); });
+
+	tango642_final( &tc );
+	tango642_final( &kt );
+
+	// PRNGs.
+
+	static PRVRNG_CTX rc;
+
+	if( prvrng_init64p2( &rc ))
+	{
+		bench_prng( "prvrng_gen64p2", buf, []( uint8_t* m, size_t l )
+			{
+				size_t j;
+
+				for( j = 0; j < l; j++ )
+				{
+					m[ j ] = prvrng_gen64p2( &rc );
+				}
+
+				return( (uint64_t) m[ 0 ]);
+			});
+
+		bench_prng( "prvrng_fill", buf, []( uint8_t* m, size_t l )
+			{ prvrng_fill( &rc, m, l ); return( (uint64_t) m[ 0 ]); });
+
+		prvrng_final64p2( &rc );
+	}
+
+	static Gradilac<> g1;
+	static Gradilac< 16 > g16;
+	static Gradilac< 4, uint64_t, 4 > g4f;
+	static GradilacPar<> gp;
+
+	bench_prng( "Gradilac<>::getRaw", buf, []( uint8_t* m, size_t l )
+		{
+			uint64_t* const o = (uint64_t*) m;
+			size_t j;
+
+			for( j = 0; j < l / 8; j++ )
+			{
+				o[ j ] = g1.getRaw();
+			}
+
+			return( o[ 0 ]);
+		});
+
+	bench_prng( "Gradilac<>::fillRaw", buf, []( uint8_t* m, size_t l )
+		{ g1.fillRaw( (uint64_t*) m, l / 8 ); return( (uint64_t) m[ 0 ]); });
+
+	bench_prng( "Gradilac<16>::fillRaw", buf, []( uint8_t* m, size_t l )
+		{ g16.fillRaw( (uint64_t*) m, l / 8 ); return( (uint64_t) m[ 0 ]); });
+
+	bench_prng( "Gradilac<4,uint64_t,4>::fillRaw", buf,
+		[]( uint8_t* m, size_t l )
+		{ g4f.fillRaw( (uint64_t*) m, l / 8 ); return( (uint64_t) m[ 0 ]); });
+
+	bench_prng( "Gradilac<>::fillDouble", buf, []( uint8_t* m, size_t l )
+		{ g1.fillDouble( (double*) m, l / 8 ); return( (uint64_t) m[ 0 ]); });
+
+	bench_prng( "Gradilac<>::fillNorm", buf, []( uint8_t* m, size_t l )
+		{ g1.fillNorm( (double*) m, l / 8 ); return( (uint64_t) m[ 0 ]); });
+
+	bench_prng( "Gradilac<>::getInt", buf, []( uint8_t* m, size_t l )
+		{
+			uint32_t* const o = (uint32_t*) m;
+			size_t j;
+
+			for( j = 0; j < l / 4; j++ )
+			{
+				o[ j ] = (uint32_t) g1.getInt( 1000003 );
+			}
+
+			return( (uint64_t) o[ 0 ]);
+		});
+
+	bench_prng( "Gradilac<>::getUInt32", buf, []( uint8_t* m, size_t l )
+		{
+			uint32_t* const o = (uint32_t*) m;
+			size_t j;
+
+			for( j = 0; j < l / 4; j++ )
+			{
+				o[ j ] = g1.getUInt32( 1000003 );
+			}
+
+			return( (uint64_t) o[ 0 ]);
+		});
+
+	bench_prng( "Gradilac<>::fillIndex", buf, []( uint8_t* m, size_t l )
+		{
+			g1.fillIndex( (size_t*) m, l / sizeof( size_t ), 1000003 );
+			return( (uint64_t) m[ 0 ]);
+		});
+
+	bench_prng( "GradilacPar<>::fillRaw", buf, []( uint8_t* m, size_t l )
+		{ gp.fillRaw( (uint64_t*) m, l / 8 ); return( (uint64_t) m[ 0 ]); });
+
+	bench_prng( "GradilacPar<>::fillDouble", buf, []( uint8_t* m, size_t l )
+		{ gp.fillDouble( (double*) m, l / 8 ); return( (uint64_t) m[ 0 ]); });
+
+	// Hash maps.
+
+	std :: vector< uint64_t > ik( BENCH_MAP_MAX );
+	std :: vector< std :: string > sk( BENCH_MAP_MAX );
+	uint64_t rv = 1;
+
+	for( k = 0; k < BENCH_MAP_MAX; k++ )
+	{
+		// Unique pseudo-random keys: an LCG's full-period outputs.
+
+		rv = rv * 6364136223846793005 + 1442695040888963407;
+		ik[ k ] = rv;
+
+		char s[ 32 ];
+		snprintf( s, sizeof( s ), "key-%016llx", (unsigned long long) rv );
+		sk[ k ] = s;
+	}
+
+	bench_map< PrvHashMap< uint64_t, size_t > >( "PrvHashMap<uint64_t>",
+		ik.data() );
+
+	bench_map< std :: unordered_map< uint64_t, size_t > >(
+		"std::unordered_map<uint64_t>", ik.data() );
+
+	bench_map< std :: unordered_map< uint64_t, size_t, BenchStdHasher > >(
+		"std::unordered_map<uint64_t,prvhash64_64m>", ik.data() );
+
+	bench_map< PrvHashMap< std :: string, size_t > >(
+		"PrvHashMap<std::string>", sk.data() );
+
+	bench_map< std :: unordered_map< std :: string, size_t > >(
+		"std::unordered_map<std::string>", sk.data() );
+
+	bench_map< std :: unordered_map< std :: string, size_t,
+		BenchStdHasher > >( "std::unordered_map<std::string,prvhash64_64m>",
+		sk.data() );
+
+	printf( "\n  ]\n}\n" );
+	free( buf );
+
+	return( 0 );
+}
@@ -36,6 +36,23 @@
 #include <stdint.h>
 #include <string.h>
 #include <math.h>
+#include <utility>
+
+// Macro that requests full unrolling of the following constant-count loop.
+
+#if defined( __clang__ )
+
+	#define GRADILAC_UNROLL _Pragma( "unroll" )
+
+#elif defined( __GNUC__ ) && __GNUC__ >= 8
+
+	#define GRADILAC_UNROLL _Pragma( "GCC unroll 16" )
+
+#else // defined( __GNUC__ )
+
+	#define GRADILAC_UNROLL
+
+#endif // defined( __GNUC__ )
 
 /**
  * Templated PRVHASH core function. For more information, please refer to the
@@ -69,152 +86,123 @@ static inline stype prvhash_core( stype* const Seed0, stype* const lcg0,
 }
 
 /**
- * Generalized templated PRVHASH-based PRNG class.
- *
- * Objects of this class do not use memory allocations and can be placed on
- * stack (if "hcount" is not large).
- *
- * Note that random values returned by functions of this class return values
- * in the "exclusive" range only, [0; 1) or [0; N). Also note that precision
- * of floating-point random numbers depends on the "stype" in use.
+ * Ziggurat tables for Normal and Exponential random number generation, used
+ * by the Gradilac class. Tables are computed on first use.
  *
- * @tparam hcount The number of hashwords in array, must be >0. E.g. use 316
- * and 64-bit "stype" to match Mersenne Twister's PRNG period.
- * @tparam stype State variable type, must be unsigned integer type, up to 64
- * bits wide. Using "stype" smaller than 24 bits is not advised.
- * @tparam fuse PRVHASH fusing, must be > 0. Should be above 1 if PRNG output
- * may be used as entropy input (output feedback), usually in open systems.
- * @tparam cs Must be >= 0. If above 0, enable CSPRNG mode. "cs" defines the
- * number of additional PRNG rounds and XOR operations, 1 is usually enough.
+ * Method is adopted from "Marsaglia, G., Tsang, W. W. 2000. "The Ziggurat
+ * Method for Generating Random Variables", Journal of Statistical Software,
+ * vol. 5, no. 8", with layer selection and rejection arranged according to
+ * "Doornik, J. A. 2005. "An Improved Ziggurat Method to Generate Normal
+ * Random Samples"".
  */
 
-template< size_t hcount = 1, typename stype = uint64_t, int fuse = 1,
-	int cs = 0 >
-class Gradilac
+struct GradilacZiggurat
 {
-public:
-	/**
-	 * Constructor. Note that copy-constructor and copy operator remain
-	 * default as class has no complex structures.
-	 *
-	 * @param iseed Initial "small" seed, can be zero.
-	 */
+	static const int NormCount = 128; ///< The number of Normal layers.
+	static const int ExpCount = 256; ///< The number of Exponential layers.
 
-	Gradilac( const stype iseed = 0 )
+	double NormX[ NormCount + 1 ]; ///< Normal layer boundaries.
+	double NormF[ NormCount + 1 ]; ///< Normal density at layer boundaries.
+	double NormR[ NormCount ]; ///< Normal quick acceptance ratios.
+	double ExpX[ ExpCount + 1 ]; ///< Exponential layer boundaries.
+	double ExpF[ ExpCount + 1 ]; ///< Exponential density at boundaries.
+	double ExpR[ ExpCount ]; ///< Exponential quick acceptance ratios.
+
+	static double normTail()
 	{
-		seed( iseed );
+		return( 3.442619855899 );
 	}
 
-	/**
-	 * Function initializes/reinitializes the PRNG. This is not the on-the-go
-	 * re-seeding. In CSPRNG mode, the "reseed" function should then be
-	 * called.
-	 *
-	 * @param iseed Initial "small" seed, can be zero.
-	 */
-
-	void seed( const stype iseed = 0 )
+	static double expTail()
 	{
-		memset( Seed, 0, fuse * sizeof( Seed[ 0 ]));
-		memset( lcg, 0, fuse * sizeof( lcg[ 0 ]));
-		memset( Hash, 0, hcount * sizeof( Hash[ 0 ]));
+		return( 7.69711747013104972 );
+	}
 
-		Seed[ 0 ] = iseed;
-		hpos = 0;
-		BitPool = 0;
-		BitsLeft = 0;
+	GradilacZiggurat()
+	{
+		// Normal distribution's density f(x)=exp(-x^2/2), layer volume V.
 
-		// Initialization involving only the first hashword, other zero
-		// hashwords will be initialized on the go: this approach was
-		// well-tested, and PRNG does produce a valid random output while
-		// initializing the hashwords.
+		const double nr = normTail();
+		const double nv = 9.91256303526217e-3;
+		int i;
 
-		int j;
+		NormX[ 0 ] = nv / exp( -0.5 * nr * nr );
+		NormX[ 1 ] = nr;
 
-		for( j = 0; j < 5; j++ )
+		for( i = 1; i < NormCount - 1; i++ )
 		{
-			int i;
-
-			for( i = 0; i < fuse; i++ )
-			{
-				prvhash_core( Seed + i, lcg + i, Hash + 0 );
-			}
+			NormX[ i + 1 ] = sqrt( -2.0 * log( nv / NormX[ i ] +
+				exp( -0.5 * NormX[ i ] * NormX[ i ])));
 		}
-	}
-
-	/**
-	 * Function re-seeds PRNG on-the-go using a single entropy value. This
-	 * function is not advised for use in CSPRNG mode. This function can be
-	 * used to efficiently adjust initial seed after the default constructor
-	 * call (iseed=0).
-	 *
-	 * @param ent Entropy value (can be any value).
-	 */
-
-	void reseed( const stype ent )
-	{
-		Seed[ 0 ] ^= ent;
-		lcg[ 0 ] ^= ent;
 
-		getRaw();
+		NormX[ NormCount ] = 0.0;
 
-		if( fuse > 1 )
+		for( i = 0; i <= NormCount; i++ )
 		{
-			getRaw();
+			NormF[ i ] = exp( -0.5 * NormX[ i ] * NormX[ i ]);
 		}
-	}
-
-	/**
-	 * Function re-seeds PRNG, starting from the current state, and using the
-	 * specified data as entropy. This function should be used in CSPRNG mode.
-	 *
-	 * @param data Entropy data block, can be of any length and of any
-	 * statistical quality. Usually it is any sequence of physics-dependent
-	 * data from physical sources like timer, keyboard, mouse, network. Or
-	 * from system's CSPRNG.
-	 * @param dlen Data length, in bytes.
-	 * @param psize Packet size, in bytes, >= 1. Should not exceed the size of
-	 * "stype". The data will be divided into packets of this size per PRNG
-	 * advancement. This value affects initialization overhead. Value of 1 is
-	 * advised for sparsely-random data. High-quality entropy can use
-	 * sizeof( stype ).
-	 */
-
-	void reseed( const void* const data, size_t dlen, const size_t psize = 1 )
-	{
-		const uint8_t* d = (const uint8_t*) data;
 
-		while( dlen > 0 )
+		for( i = 0; i < NormCount; i++ )
 		{
-			size_t l = ( psize > dlen ? dlen : psize );
-			dlen -= l;
-			stype p = 0; // Packet.
+			NormR[ i ] = NormX[ i + 1 ] / NormX[ i ];
+		}
 
-			while( l > 0 )
-			{
-				p <<= 8;
-				p |= *d;
+		// Exponential distribution's density f(x)=exp(-x), layer volume V.
 
-				d++;
-				l--;
-			}
+		const double er = expTail();
+		const double ev = 3.949659822581572e-3;
 
-			Seed[ 0 ] ^= p;
-			lcg[ 0 ] ^= p;
+		ExpX[ 0 ] = ev / exp( -er );
+		ExpX[ 1 ] = er;
 
-			getRaw();
+		for( i = 1; i < ExpCount - 1; i++ )
+		{
+			ExpX[ i + 1 ] = -log( ev / ExpX[ i ] + exp( -ExpX[ i ]));
 		}
 
-		// Make hashword array pass to eliminate traces of input entropy.
+		ExpX[ ExpCount ] = 0.0;
 
-		int i;
+		for( i = 0; i <= ExpCount; i++ )
+		{
+			ExpF[ i ] = exp( -ExpX[ i ]);
+		}
 
-		for( i = 0; i < hcount + ( hcount > 1 ) + ( fuse > 1 ); i++ )
+		for( i = 0; i < ExpCount; i++ )
 		{
-			getRaw();
+			ExpR[ i ] = ExpX[ i + 1 ] / ExpX[ i ];
 		}
 	}
 
+	/**
+	 * @return Shared instance of the tables.
+	 */
+
+	static const GradilacZiggurat& get()
+	{
+		static const GradilacZiggurat z;
+
+		return( z );
+	}
+};
+
+/**
+ * Front-end of the Gradilac PRNG classes, implements random number
+ * generation functions on top of the "getRaw" and "fillConv" functions of the
+ * derived PRNG class.
+ *
+ * Note that random values returned by functions of this class return values
+ * in the "exclusive" range only, [0; 1) or [0; N). Also note that precision
+ * of floating-point random numbers depends on the "stype" in use.
+ *
+ * @tparam stype State variable type, must be unsigned integer type, up to 64
+ * bits wide.
+ * @tparam gtype Derived PRNG class.
+ */
+
+template< typename stype, typename gtype >
+class GradilacBase
+{
+public:
 	/**
 	 * @return The next floating-point random number in [0; 1) range.
 	 */
@@ -259,140 +247,378 @@ public:
 	}
 
 	/**
-	 * @return The next random integer number in the "raw", stype-value range.
-	 * This is the actual PRNG advancement function.
+	 * @return The next random integer number in the "raw", stype-value range,
+	 * produced by the derived PRNG class.
 	 */
 
 	stype getRaw()
 	{
-		stype* h = Hash + hpos;
-
-		if( ++hpos == hcount )
-		{
-			hpos = 0;
-		}
+		return( static_cast< gtype* >( this ) -> getRaw() );
+	}
 
-		int i;
+	/**
+	 * @return The next random integer number in [0; N1) range (note the N's
+	 * exclusivity). N1 specifies positive number of discrete bins, and not
+	 * the extreme value.
+	 */
 
-		for( i = 0; i < fuse - 1; i++ )
-		{
-			prvhash_core( Seed + i, lcg + i, h );
-		}
+	int getInt( const int N1 )
+	{
+		return( (int) get( (double) N1 ));
+	}
 
-		stype res = prvhash_core( Seed + i, lcg + i, h );
+	/**
+	 * @return The next unbiased random integer number in [0; N1) range,
+	 * using Lemire's multiply-shift method: "Lemire, D. 2019. "Fast Random
+	 * Integer Generation in an Interval", ACM Transactions on Modeling and
+	 * Computer Simulation, vol. 29, no. 1". 32 random bits are taken from the
+	 * bit pool per call, in most cases.
+	 *
+	 * @param N1 The number of discrete bins, > 0.
+	 */
 
-		int j;
+	uint32_t getUInt32( const uint32_t N1 )
+	{
+		uint64_t m = (uint64_t) getRaw32() * N1;
 
-		for( j = 0; j < cs; j++ )
+		if( (uint32_t) m < N1 )
 		{
-			h = Hash + hpos;
+			const uint32_t t = (uint32_t) ( 0 - N1 ) % N1;
 
-			if( ++hpos == hcount )
-			{
-				hpos = 0;
-			}
-
-			for( i = 0; i < fuse - 1; i++ )
+			while( (uint32_t) m < t )
 			{
-				prvhash_core( Seed + i, lcg + i, h );
+				m = (uint64_t) getRaw32() * N1;
 			}
-
-			res ^= prvhash_core( Seed + i, lcg + i, h );
 		}
 
-		return( res );
+		return( (uint32_t) ( m >> 32 ));
 	}
 
 	/**
-	 * @return The next random integer number in [0; N1) range (note the N's
-	 * exclusivity). N1 specifies positive number of discrete bins, and not
-	 * the extreme value.
+	 * @return The next unbiased random integer number in [0; N1) range,
+	 * using Lemire's multiply-shift method, see the getUInt32() function.
+	 *
+	 * @param N1 The number of discrete bins, > 0.
 	 */
 
-	int getInt( const int N1 )
+	uint64_t getUInt64( const uint64_t N1 )
 	{
-		return( (int) get( (double) N1 ));
+		uint64_t l;
+		uint64_t h = mul64( getRaw64(), N1, l );
+
+		if( l < N1 )
+		{
+			const uint64_t t = ( 0 - N1 ) % N1;
+
+			while( l < t )
+			{
+				h = mul64( getRaw64(), N1, l );
+			}
+		}
+
+		return( h );
 	}
 
 	/**
-	 * @return The next squared floating-point random number in [0; 1) range.
-	 * This is Beta distribution, with alpha=0.5, beta=1.
+	 * @return The next unbiased random index in [0; N1) range, via the
+	 * getUInt32() function if N1 fits 32 bits, and via the getUInt64()
+	 * function otherwise.
+	 *
+	 * @param N1 The number of discrete bins, > 0.
 	 */
 
-	double getSqr()
+	size_t getIndex( const size_t N1 )
 	{
-		const double v = get();
+		if( (uint64_t) N1 <= 0xFFFFFFFF )
+		{
+			return( (size_t) getUInt32( (uint32_t) N1 ));
+		}
 
-		return( v * v );
+		return( (size_t) getUInt64( (uint64_t) N1 ));
 	}
 
 	/**
-	 * @return TPDF random number in the range (-1; 1). Note that this
-	 * function uses an optimized variant, with 32-bit precision, when
-	 * stype=uint64_t.
+	 * @return The next "n"-bit random integer number, taken from the bit
+	 * pool, which is shared with the getBit() function. The bit pool is
+	 * refilled with a raw value if it holds less than "n" bits.
+	 *
+	 * @param n The number of bits, 1 to the bit width of "stype".
 	 */
 
-	double getTPDF()
+	uint64_t getBits( const int n )
 	{
-		if( sizeof( stype ) == 8 )
+		if( BitsLeft < n )
 		{
-			const stype rv = getRaw();
-
-			return(( (int64_t) ( rv >> 32 ) - (int64_t) (uint32_t) rv ) *
-				0x1p-32 );
+			BitPool = getRaw();
+			BitsLeft = (int) sizeof( stype ) * 8;
 		}
-		else
-		if( sizeof( stype ) * 8 > 53 )
-		{
-			const double v1 = get();
-			const double v2 = get();
 
-			return( v1 - v2 );
-		}
-		else
-		{
-			const double v1 = (double) getRaw();
-			const double v2 = (double) getRaw();
+		const uint64_t v = (uint64_t) BitPool & ( ~(uint64_t) 0 >> ( 64 - n ));
 
-			return(( v1 - v2 ) * im() );
-		}
+		BitsLeft -= n;
+		BitPool = (stype) ( BitPool >> ( n - 1 ) >> 1 );
+
+		return( v );
 	}
 
 	/**
-	 * Function generates a Gaussian (normal)-distributed pseudo-random number
-	 * with mean=0 and std.dev=1.
+	 * Function fills the specified buffer with unbiased random indices in
+	 * [0; N1) range. If N1 is a power of 2, the indices are taken from the
+	 * bit pool, several indices per raw value.
 	 *
-	 * Algorithm is adopted from "Leva, J. L. 1992. "A Fast Normal Random
-	 * Number Generator", ACM Transactions on Mathematical Software, vol. 18,
-	 * no. 4, pp. 449-453".
+	 * @param[out] out Output buffer.
+	 * @param n The number of indices to produce.
+	 * @param N1 The number of discrete bins, > 0.
 	 */
 
-	double getNorm()
+	void fillIndex( size_t* const out, const size_t n, const size_t N1 )
 	{
-		double q, u, v;
+		size_t k;
 
-		do
+		if(( N1 & ( N1 - 1 )) == 0 && (uint64_t) N1 - 1 <=
+			( ~(uint64_t) 0 >> ( 64 - sizeof( stype ) * 8 )))
 		{
-			u = get();
-			v = get();
+			int b = 0;
 
-			if( u == 0.0 || v == 0.0 )
+			while( ( (size_t) 1 << b ) < N1 )
 			{
-				u = 1.0;
-				v = 1.0;
+				b++;
 			}
 
-			v = 1.7156 * ( v - 0.5 );
-			const double x = u - 0.449871;
-			const double y = fabs( v ) + 0.386595;
-			q = x * x + y * ( 0.19600 * y - 0.25472 * x );
+			if( b == 0 )
+			{
+				memset( out, 0, n * sizeof( out[ 0 ]));
+				return;
+			}
 
-			if( q < 0.27597 )
+			for( k = 0; k < n; k++ )
 			{
-				break;
+				out[ k ] = (size_t) getBits( b );
 			}
 
-		} while( q > 0.27846 || v * v > -4.0 * log( u ) * u * u );
+			return;
+		}
+
+		for( k = 0; k < n; k++ )
+		{
+			out[ k ] = getIndex( N1 );
+		}
+	}
+
+	/**
+	 * Function shuffles the specified array, using the Fisher-Yates
+	 * (Durstenfeld's) algorithm with unbiased random indices.
+	 *
+	 * @param[in,out] a Array to shuffle.
+	 * @param n The number of elements in the array.
+	 * @tparam T Element's type, should be swappable.
+	 */
+
+	template< typename T >
+	void shuffle( T* const a, const size_t n )
+	{
+		size_t i;
+
+		for( i = n; i > 1; i-- )
+		{
+			const size_t j = getIndex( i );
+
+			if( j != i - 1 )
+			{
+				std :: swap( a[ i - 1 ], a[ j ]);
+			}
+		}
+	}
+
+	/**
+	 * Function selects a uniformly-random sample of "k" elements of the
+	 * specified array, using the reservoir sampling algorithm "L", from "Li,
+	 * K.-H. 1994. "Reservoir-Sampling Algorithms of Time Complexity
+	 * O(n(1 + log(N/n)))", ACM Transactions on Mathematical Software,
+	 * vol. 20, no. 4, pp. 481-493". If n > k, the selected elements are
+	 * shuffled, and their order is random; otherwise, the input array is
+	 * copied as is.
+	 *
+	 * @param in Input array.
+	 * @param n The number of elements in the input array.
+	 * @param[out] out Output array, "k" elements.
+	 * @param k The required sample size.
+	 * @tparam T Element's type, should be copy-assignable.
+	 * @return The number of selected elements, min( n, k ).
+	 */
+
+	template< typename T >
+	size_t sample( const T* const in, const size_t n, T* const out,
+		const size_t k )
+	{
+		size_t i;
+
+		for( i = 0; i < n && i < k; i++ )
+		{
+			out[ i ] = in[ i ];
+		}
+
+		if( n <= k )
+		{
+			return( n );
+		}
+
+		if( k == 0 )
+		{
+			return( 0 );
+		}
+
+		const double ik = 1.0 / (double) k;
+		double w = exp( log( getNZ() ) * ik );
+		i = k - 1;
+
+		while( true )
+		{
+			const double s = floor( log( getNZ() ) / log1p( -w ));
+
+			if( !( s < (double) ( n - 1 - i )))
+			{
+				break;
+			}
+
+			i += (size_t) s + 1;
+			out[ getIndex( k )] = in[ i ];
+			w *= exp( log( getNZ() ) * ik );
+		}
+
+		// Unreplaced elements of the reservoir retain the input order.
+
+		shuffle( out, k );
+
+		return( k );
+	}
+
+	/**
+	 * Adapter class that conforms to the C++ "uniform random bit generator"
+	 * requirements, for use with the standard library's functions, like
+	 * std::shuffle(), and distributions. Produces the getRaw() values of the
+	 * referenced PRNG.
+	 */
+
+	class URBG
+	{
+	public:
+		typedef stype result_type; ///< Type of produced values.
+
+		explicit URBG( gtype& rng0 )
+			: rng( rng0 )
+		{
+		}
+
+		static constexpr result_type min()
+		{
+			return( 0 );
+		}
+
+		static constexpr result_type max()
+		{
+			return( (result_type) ~(result_type) 0 );
+		}
+
+		result_type operator()()
+		{
+			return( rng.getRaw() );
+		}
+
+	protected:
+		gtype& rng; ///< Referenced PRNG.
+	};
+
+	/**
+	 * @return The URBG adapter referencing this PRNG. Note that the
+	 * operator() of this class produces floating-point values, and cannot be
+	 * used as a "uniform random bit generator".
+	 */
+
+	URBG getURBG()
+	{
+		return( URBG( *static_cast< gtype* >( this )));
+	}
+
+	/**
+	 * @return The next squared floating-point random number in [0; 1) range.
+	 * This is Beta distribution, with alpha=0.5, beta=1.
+	 */
+
+	double getSqr()
+	{
+		const double v = get();
+
+		return( v * v );
+	}
+
+	/**
+	 * @return TPDF random number in the range (-1; 1). Note that this
+	 * function uses an optimized variant, with 32-bit precision, when
+	 * stype=uint64_t.
+	 */
+
+	double getTPDF()
+	{
+		if( sizeof( stype ) == 8 )
+		{
+			const stype rv = getRaw();
+
+			return(( (int64_t) ( rv >> 32 ) - (int64_t) (uint32_t) rv ) *
+				0x1p-32 );
+		}
+		else
+		if( sizeof( stype ) * 8 > 53 )
+		{
+			const double v1 = get();
+			const double v2 = get();
+
+			return( v1 - v2 );
+		}
+		else
+		{
+			const double v1 = (double) getRaw();
+			const double v2 = (double) getRaw();
+
+			return(( v1 - v2 ) * im() );
+		}
+	}
+
+	/**
+	 * Function generates a Gaussian (normal)-distributed pseudo-random number
+	 * with mean=0 and std.dev=1.
+	 *
+	 * Algorithm is adopted from "Leva, J. L. 1992. "A Fast Normal Random
+	 * Number Generator", ACM Transactions on Mathematical Software, vol. 18,
+	 * no. 4, pp. 449-453".
+	 */
+
+	double getNorm()
+	{
+		double q, u, v;
+
+		do
+		{
+			u = get();
+			v = get();
+
+			if( u == 0.0 || v == 0.0 )
+			{
+				u = 1.0;
+				v = 1.0;
+			}
+
+			v = 1.7156 * ( v - 0.5 );
+			const double x = u - 0.449871;
+			const double y = fabs( v ) + 0.386595;
+			q = x * x + y * ( 0.19600 * y - 0.25472 * x );
+
+			if( q < 0.27597 )
+			{
+				break;
+			}
+
+		} while( q > 0.27846 || v * v > -4.0 * log( u ) * u * u );
 
 		return( v / u );
 	}
@@ -435,33 +661,1226 @@ public:
 	}
 
 	/**
-	 * @return PRNG period's exponent (2^N) estimation.
+	 * Function fills the specified buffer with random integer numbers in the
+	 * "raw", stype-value range. The produced sequence is equal to a sequence
+	 * of getRaw() function calls.
+	 *
+	 * @param[out] out Output buffer.
+	 * @param n The number of values to produce.
 	 */
 
-	static size_t getPeriodExp()
+	void fillRaw( stype* const out, const size_t n )
 	{
-		return(( fuse * 8 + fuse * 4 + hcount * 8 ) * sizeof( stype ) -
-			hcount - cs );
+		static_cast< gtype* >( this ) -> template
+			fillConv< stype, ConvRaw >( out, n );
 	}
 
-protected:
-	stype Seed[ fuse ]; ///< PRNG seeds (>1 - fused).
-	stype lcg[ fuse ]; ///< PRNG lcg (>1 - fused).
-	stype Hash[ hcount ]; ///< PRNG hash array.
-	size_t hpos; ///< Hash array position (increments linearly, resets to 0).
-	stype BitPool; ///< Bit pool, optional feature.
-	int BitsLeft; ///< The number of bits left in the bit pool.
+	/**
+	 * Function fills the specified buffer with floating-point random numbers
+	 * in [0; 1) range. The produced sequence is equal to a sequence of get()
+	 * function calls.
+	 *
+	 * @param[out] out Output buffer.
+	 * @param n The number of values to produce.
+	 */
+
+	void fillDouble( double* const out, const size_t n )
+	{
+		static_cast< gtype* >( this ) -> template
+			fillConv< double, ConvDouble >( out, n );
+	}
 
 	/**
-	 * @return Inverse multiplier to scale stype's value range to [0; 1)
-	 * range.
+	 * Function fills the specified buffer with single-precision
+	 * floating-point random numbers in [0; 1) range.
+	 *
+	 * @param[out] out Output buffer.
+	 * @param n The number of values to produce.
 	 */
 
-	static double im()
+	void fillFloat( float* const out, const size_t n )
 	{
-		static const double v = 0.5 / ( 1ULL << ( sizeof( stype ) * 8 - 1 ));
+		static_cast< gtype* >( this ) -> template
+			fillConv< float, ConvFloat >( out, n );
+	}
 
-		return( v );
+	/**
+	 * Function fills the specified buffer with TPDF random numbers in the
+	 * range (-1; 1). The produced sequence is equal to a sequence of
+	 * getTPDF() function calls.
+	 *
+	 * @param[out] out Output buffer.
+	 * @param n The number of values to produce.
+	 */
+
+	void fillTPDF( double* const out, const size_t n )
+	{
+		if( sizeof( stype ) == 8 )
+		{
+			static_cast< gtype* >( this ) -> template
+			fillConv< double, ConvTPDF >( out, n );
+		}
+		else
+		{
+			size_t k;
+
+			for( k = 0; k < n; k++ )
+			{
+				out[ k ] = getTPDF();
+			}
+		}
+	}
+
+	/**
+	 * Function generates a Gaussian (normal)-distributed pseudo-random number
+	 * with mean=0 and std.dev=1, using the Ziggurat method. This function is
+	 * several times faster than the getNorm() function, and it uses a single
+	 * 64-bit raw value in most cases, but produces a different sequence.
+	 */
+
+	double getNormZig()
+	{
+		const GradilacZiggurat& z = GradilacZiggurat :: get();
+
+		while( true )
+		{
+			const uint64_t rv = getRaw64();
+			const int i = (int) ( rv & ( GradilacZiggurat :: NormCount - 1 ));
+			const double u = ( rv >> 11 ) * 0x1p-52 - 1.0;
+
+			if( fabs( u ) < z.NormR[ i ])
+			{
+				return( u * z.NormX[ i ]);
+			}
+
+			if( i == 0 )
+			{
+				// Sample from the tail.
+
+				const double r = GradilacZiggurat :: normTail();
+				double x, y;
+
+				do
+				{
+					x = log( getNZ() ) / r;
+					y = log( getNZ() );
+				} while( -2.0 * y < x * x );
+
+				return( u < 0.0 ? x - r : r - x );
+			}
+
+			const double x = u * z.NormX[ i ];
+
+			if( z.NormF[ i ] + get() * ( z.NormF[ i + 1 ] - z.NormF[ i ]) <
+				exp( -0.5 * x * x ))
+			{
+				return( x );
+			}
+		}
+	}
+
+	/**
+	 * Function generates an Exponentially-distributed pseudo-random number
+	 * with rate=1 (mean=1), using the Ziggurat method.
+	 */
+
+	double getExp()
+	{
+		const GradilacZiggurat& z = GradilacZiggurat :: get();
+
+		while( true )
+		{
+			const uint64_t rv = getRaw64();
+			const int i = (int) ( rv & ( GradilacZiggurat :: ExpCount - 1 ));
+			const double u = ( rv >> 11 ) * 0x1p-53;
+
+			if( u < z.ExpR[ i ])
+			{
+				return( u * z.ExpX[ i ]);
+			}
+
+			if( i == 0 )
+			{
+				// The tail is Exponential as well, offset by "r".
+
+				return( GradilacZiggurat :: expTail() - log( getNZ() ));
+			}
+
+			const double x = u * z.ExpX[ i ];
+
+			if( z.ExpF[ i ] + get() * ( z.ExpF[ i + 1 ] - z.ExpF[ i ]) <
+				exp( -x ))
+			{
+				return( x );
+			}
+		}
+	}
+
+	/**
+	 * Function generates a Gamma-distributed pseudo-random number with the
+	 * specified shape, and scale=1.
+	 *
+	 * Algorithm is adopted from "Marsaglia, G., Tsang, W. W. 2000. "A Simple
+	 * Method for Generating Gamma Variables", ACM Transactions on
+	 * Mathematical Software, vol. 26, no. 3, pp. 363-372".
+	 *
+	 * @param shape Shape parameter (k or alpha), > 0.
+	 */
+
+	double getGamma( const double shape )
+	{
+		if( shape < 1.0 )
+		{
+			return( getGamma( shape + 1.0 ) * pow( getNZ(), 1.0 / shape ));
+		}
+
+		const double d = shape - 1.0 / 3.0;
+		const double c = 1.0 / sqrt( 9.0 * d );
+
+		while( true )
+		{
+			const double x = getNormZig();
+			double v = 1.0 + c * x;
+
+			if( v <= 0.0 )
+			{
+				continue;
+			}
+
+			v = v * v * v;
+			const double u = getNZ();
+			const double x2 = x * x;
+
+			if( u < 1.0 - 0.0331 * x2 * x2 ||
+				log( u ) < 0.5 * x2 + d * ( 1.0 - v + log( v )))
+			{
+				return( d * v );
+			}
+		}
+	}
+
+	/**
+	 * Function generates a Poisson-distributed pseudo-random number with the
+	 * specified mean. Small means use Exponential inter-arrival times; means
+	 * of 10 and above use the transformed rejection method from "Hormann, W.
+	 * 1993. "The transformed rejection method for generating Poisson random
+	 * variables", Insurance: Mathematics and Economics, vol. 12, no. 1,
+	 * pp. 39-45".
+	 *
+	 * @param mean Mean (lambda), >= 0.
+	 */
+
+	size_t getPoisson( const double mean )
+	{
+		if( mean < 10.0 )
+		{
+			size_t k = 0;
+			double t = getExp();
+
+			while( t <= mean )
+			{
+				k++;
+				t += getExp();
+			}
+
+			return( k );
+		}
+
+		const double slam = sqrt( mean );
+		const double loglam = log( mean );
+		const double b = 0.931 + 2.53 * slam;
+		const double a = -0.059 + 0.02483 * b;
+		const double invalpha = 1.1239 + 1.1328 / ( b - 3.4 );
+		const double vr = 0.9277 - 3.6224 / ( b - 2.0 );
+
+		while( true )
+		{
+			const double u = get() - 0.5;
+			const double v = get();
+			const double us = 0.5 - fabs( u );
+			const double k = floor(( 2.0 * a / us + b ) * u + mean + 0.43 );
+
+			if( us >= 0.07 && v <= vr )
+			{
+				return( (size_t) k );
+			}
+
+			if( k < 0.0 || ( us < 0.013 && v > us ))
+			{
+				continue;
+			}
+
+			if( log( v ) + log( invalpha ) - log( a / ( us * us ) + b ) <=
+				-mean + k * loglam - lgamma( k + 1.0 ))
+			{
+				return( (size_t) k );
+			}
+		}
+	}
+
+	/**
+	 * Function fills the specified buffer with Gaussian (normal)-distributed
+	 * pseudo-random numbers with mean=0 and std.dev=1. The produced sequence
+	 * is equal to a sequence of getNormZig() function calls.
+	 *
+	 * @param[out] out Output buffer.
+	 * @param n The number of values to produce.
+	 */
+
+	void fillNorm( double* const out, const size_t n )
+	{
+		size_t k;
+
+		for( k = 0; k < n; k++ )
+		{
+			out[ k ] = getNormZig();
+		}
+	}
+
+	/**
+	 * Function fills the specified buffer with Gaussian (normal)-distributed
+	 * pseudo-random numbers with the specified mean and std.dev.
+	 *
+	 * @param[out] out Output buffer.
+	 * @param n The number of values to produce.
+	 * @param mean Mean.
+	 * @param stddev Standard deviation.
+	 */
+
+	void fillNorm( double* const out, const size_t n, const double mean,
+		const double stddev )
+	{
+		size_t k;
+
+		for( k = 0; k < n; k++ )
+		{
+			out[ k ] = mean + stddev * getNormZig();
+		}
+	}
+
+	/**
+	 * Function fills the specified buffer with Exponentially-distributed
+	 * pseudo-random numbers with rate=1. The produced sequence is equal to a
+	 * sequence of getExp() function calls.
+	 *
+	 * @param[out] out Output buffer.
+	 * @param n The number of values to produce.
+	 */
+
+	void fillExp( double* const out, const size_t n )
+	{
+		size_t k;
+
+		for( k = 0; k < n; k++ )
+		{
+			out[ k ] = getExp();
+		}
+	}
+
+	/**
+	 * Function fills the specified buffer with Gamma-distributed
+	 * pseudo-random numbers with the specified shape, and scale=1.
+	 *
+	 * @param[out] out Output buffer.
+	 * @param n The number of values to produce.
+	 * @param shape Shape parameter, > 0.
+	 */
+
+	void fillGamma( double* const out, const size_t n, const double shape )
+	{
+		size_t k;
+
+		for( k = 0; k < n; k++ )
+		{
+			out[ k ] = getGamma( shape );
+		}
+	}
+
+	/**
+	 * Function fills the specified buffer with Poisson-distributed
+	 * pseudo-random numbers with the specified mean.
+	 *
+	 * @param[out] out Output buffer.
+	 * @param n The number of values to produce.
+	 * @param mean Mean, >= 0.
+	 */
+
+	void fillPoisson( size_t* const out, const size_t n, const double mean )
+	{
+		size_t k;
+
+		for( k = 0; k < n; k++ )
+		{
+			out[ k ] = getPoisson( mean );
+		}
+	}
+
+	/**
+	 * Function initializes "k" child PRNGs of the same type, for use as
+	 * independent streams, e.g., by worker threads. A 256-bit spawn key is
+	 * drawn from this PRNG (advancing it), and each child is seeded with
+	 * zero and re-seeded with its index and the spawn key. Child "i" depends
+	 * only on this PRNG's state and "i", and not on "k": the streams remain
+	 * reproducible when a simulation is sharded into a fixed number of
+	 * children, irrespective of the number of threads in use.
+	 *
+	 * @param[out] children Child PRNGs, "k" items.
+	 * @param k The number of children to initialize.
+	 */
+
+	void spawn( gtype* const children, const size_t k )
+	{
+		uint8_t d[ 40 ]; // Child's index and spawn key, little-endian.
+		int i;
+
+		for( i = 8; i < 40; i += 8 )
+		{
+			uint64_t v = getRaw64();
+			int j;
+
+			for( j = 0; j < 8; j++ )
+			{
+				d[ i + j ] = (uint8_t) v;
+				v >>= 8;
+			}
+		}
+
+		size_t c;
+
+		for( c = 0; c < k; c++ )
+		{
+			uint64_t v = (uint64_t) c;
+
+			for( i = 0; i < 8; i++ )
+			{
+				d[ i ] = (uint8_t) v;
+				v >>= 8;
+			}
+
+			children[ c ].seed( 0 );
+			children[ c ].reseed( d, sizeof( d ), sizeof( stype ));
+		}
+
+		memset( d, 0, sizeof( d ));
+	}
+
+	/**
+	 * @return A child PRNG, equal to the first child produced by the spawn()
+	 * function. This PRNG is advanced.
+	 */
+
+	gtype split()
+	{
+		gtype c;
+		spawn( &c, 1 );
+
+		return( c );
+	}
+
+protected:
+	stype BitPool; ///< Bit pool, optional feature.
+	int BitsLeft; ///< The number of bits left in the bit pool.
+
+	/**
+	 * @return Inverse multiplier to scale stype's value range to [0; 1)
+	 * range.
+	 */
+
+	static double im()
+	{
+		static const double v = 0.5 / ( 1ULL << ( sizeof( stype ) * 8 - 1 ));
+
+		return( v );
+	}
+
+	/**
+	 * @return The next 64-bit random value, assembled from several raw
+	 * values if "stype" is smaller than 64 bits.
+	 */
+
+	uint64_t getRaw64()
+	{
+		if( sizeof( stype ) >= 8 )
+		{
+			return( (uint64_t) getRaw() );
+		}
+
+		uint64_t v = 0;
+		size_t k;
+
+		for( k = 0; k < 8; k += sizeof( stype ))
+		{
+			v = ( v << ( sizeof( stype ) * 4 )) << ( sizeof( stype ) * 4 );
+			v |= getRaw();
+		}
+
+		return( v );
+	}
+
+	/**
+	 * @return The next 32-bit random value, taken from the bit pool if
+	 * "stype" is at least 32 bits wide.
+	 */
+
+	uint32_t getRaw32()
+	{
+		if( sizeof( stype ) >= 4 )
+		{
+			return( (uint32_t) getBits( 32 ));
+		}
+
+		return( (uint32_t) ( getRaw64() >> 32 ));
+	}
+
+	/**
+	 * Function multiplies two 64-bit values.
+	 *
+	 * @param a Multiplier.
+	 * @param b Multiplier.
+	 * @param[out] rl The lower 64 bits of the 128-bit result.
+	 * @return The higher 64 bits of the 128-bit result.
+	 */
+
+	static uint64_t mul64( const uint64_t a, const uint64_t b, uint64_t& rl )
+	{
+		#if defined( __SIZEOF_INT128__ )
+
+			const unsigned __int128 r = (unsigned __int128) a * b;
+			rl = (uint64_t) r;
+
+			return( (uint64_t) ( r >> 64 ));
+
+		#else // defined( __SIZEOF_INT128__ )
+
+			const uint64_t al = (uint32_t) a;
+			const uint64_t ah = a >> 32;
+			const uint64_t bl = (uint32_t) b;
+			const uint64_t bh = b >> 32;
+			const uint64_t ll = al * bl;
+			const uint64_t m1 = ah * bl + ( ll >> 32 );
+			const uint64_t m2 = al * bh + (uint32_t) m1;
+
+			rl = m2 << 32 | (uint32_t) ll;
+
+			return( ah * bh + ( m1 >> 32 ) + ( m2 >> 32 ));
+
+		#endif // defined( __SIZEOF_INT128__ )
+	}
+
+	/**
+	 * @return The next floating-point random number in (0; 1] range, for
+	 * safe use with the log() function.
+	 */
+
+	double getNZ()
+	{
+		return( 1.0 - get() );
+	}
+
+	/**
+	 * Raw value converters used by the fillConv() function.
+	 */
+
+	struct ConvRaw
+	{
+		static stype conv( const stype v )
+		{
+			return( v );
+		}
+	};
+
+	struct ConvDouble
+	{
+		static double conv( const stype v )
+		{
+			if( sizeof( stype ) * 8 > 53 )
+			{
+				return(( v >> ( sizeof( stype ) * 8 - 53 )) * 0x1p-53 );
+			}
+			else
+			{
+				return( v * im() );
+			}
+		}
+	};
+
+	struct ConvFloat
+	{
+		static float conv( const stype v )
+		{
+			if( sizeof( stype ) * 8 > 24 )
+			{
+				return( (float) (uint32_t) ( v >>
+					( sizeof( stype ) * 8 - 24 )) * 0x1p-24f );
+			}
+			else
+			{
+				return( (float) ( v * im() ));
+			}
+		}
+	};
+
+	struct ConvTPDF
+	{
+		static double conv( const stype v )
+		{
+			return(( (int64_t) ( (uint64_t) v >> 32 ) -
+				(int64_t) (uint32_t) v ) * 0x1p-32 );
+		}
+	};
+};
+
+/**
+ * Generalized templated PRVHASH-based PRNG class.
+ *
+ * Objects of this class do not use memory allocations and can be placed on
+ * stack (if "hcount" is not large).
+ *
+ * @tparam hcount The number of hashwords in array, must be >0. E.g. use 316
+ * and 64-bit "stype" to match Mersenne Twister's PRNG period.
+ * @tparam stype State variable type, must be unsigned integer type, up to 64
+ * bits wide. Using "stype" smaller than 24 bits is not advised.
+ * @tparam fuse PRVHASH fusing, must be > 0. Should be above 1 if PRNG output
+ * may be used as entropy input (output feedback), usually in open systems.
+ * @tparam cs Must be >= 0. If above 0, enable CSPRNG mode. "cs" defines the
+ * number of additional PRNG rounds and XOR operations, 1 is usually enough.
+ */
+
+template< size_t hcount = 1, typename stype = uint64_t, int fuse = 1,
+	int cs = 0 >
+class Gradilac : public GradilacBase< stype,
+	Gradilac< hcount, stype, fuse, cs > >
+{
+	friend class GradilacBase< stype, Gradilac >;
+
+public:
+	/**
+	 * Constructor. Note that copy-constructor and copy operator remain
+	 * default as class has no complex structures.
+	 *
+	 * @param iseed Initial "small" seed, can be zero.
+	 */
+
+	Gradilac( const stype iseed = 0 )
+	{
+		seed( iseed );
+	}
+
+	/**
+	 * Function initializes/reinitializes the PRNG. This is not the on-the-go
+	 * re-seeding. In CSPRNG mode, the "reseed" function should then be
+	 * called.
+	 *
+	 * @param iseed Initial "small" seed, can be zero.
+	 */
+
+	void seed( const stype iseed = 0 )
+	{
+		memset( Seed, 0, fuse * sizeof( Seed[ 0 ]));
+		memset( lcg, 0, fuse * sizeof( lcg[ 0 ]));
+		memset( Hash, 0, hcount * sizeof( Hash[ 0 ]));
+
+		Seed[ 0 ] = iseed;
+		hpos = 0;
+		this -> BitPool = 0;
+		this -> BitsLeft = 0;
+
+		// Initialization involving only the first hashword, other zero
+		// hashwords will be initialized on the go: this approach was
+		// well-tested, and PRNG does produce a valid random output while
+		// initializing the hashwords.
+
+		int j;
+
+		for( j = 0; j < 5; j++ )
+		{
+			int i;
+
+			for( i = 0; i < fuse; i++ )
+			{
+				prvhash_core( Seed + i, lcg + i, Hash + 0 );
+			}
+		}
+	}
+
+	/**
+	 * Function re-seeds PRNG on-the-go using a single entropy value. This
+	 * function is not advised for use in CSPRNG mode. This function can be
+	 * used to efficiently adjust initial seed after the default constructor
+	 * call (iseed=0).
+	 *
+	 * @param ent Entropy value (can be any value).
+	 */
+
+	void reseed( const stype ent )
+	{
+		Seed[ 0 ] ^= ent;
+		lcg[ 0 ] ^= ent;
+
+		getRaw();
+
+		if( fuse > 1 )
+		{
+			getRaw();
+		}
+	}
+
+	/**
+	 * Function re-seeds PRNG, starting from the current state, and using the
+	 * specified data as entropy. This function should be used in CSPRNG mode.
+	 *
+	 * @param data Entropy data block, can be of any length and of any
+	 * statistical quality. Usually it is any sequence of physics-dependent
+	 * data from physical sources like timer, keyboard, mouse, network. Or
+	 * from system's CSPRNG.
+	 * @param dlen Data length, in bytes.
+	 * @param psize Packet size, in bytes, >= 1. Should not exceed the size of
+	 * "stype". The data will be divided into packets of this size per PRNG
+	 * advancement. This value affects initialization overhead. Value of 1 is
+	 * advised for sparsely-random data. High-quality entropy can use
+	 * sizeof( stype ).
+	 */
+
+	void reseed( const void* const data, size_t dlen, const size_t psize = 1 )
+	{
+		const uint8_t* d = (const uint8_t*) data;
+
+		while( dlen > 0 )
+		{
+			size_t l = ( psize > dlen ? dlen : psize );
+			dlen -= l;
+			stype p = 0; // Packet.
+
+			while( l > 0 )
+			{
+				p <<= 8;
+				p |= *d;
+
+				d++;
+				l--;
+			}
+
+			Seed[ 0 ] ^= p;
+			lcg[ 0 ] ^= p;
+
+			getRaw();
+		}
+
+		// Make hashword array pass to eliminate traces of input entropy.
+
+		int i;
+
+		for( i = 0; i < hcount + ( hcount > 1 ) + ( fuse > 1 ); i++ )
+		{
+			getRaw();
+		}
+	}
+
+	/**
+	 * @return The next random integer number in the "raw", stype-value range.
+	 * This is the actual PRNG advancement function.
+	 */
+
+	stype getRaw()
+	{
+		stype* h = Hash + hpos;
+
+		if( ++hpos == hcount )
+		{
+			hpos = 0;
+		}
+
+		int i;
+
+		for( i = 0; i < fuse - 1; i++ )
+		{
+			prvhash_core( Seed + i, lcg + i, h );
+		}
+
+		stype res = prvhash_core( Seed + i, lcg + i, h );
+
+		int j;
+
+		for( j = 0; j < cs; j++ )
+		{
+			h = Hash + hpos;
+
+			if( ++hpos == hcount )
+			{
+				hpos = 0;
+			}
+
+			for( i = 0; i < fuse - 1; i++ )
+			{
+				prvhash_core( Seed + i, lcg + i, h );
+			}
+
+			res ^= prvhash_core( Seed + i, lcg + i, h );
+		}
+
+		return( res );
+	}
+
+	/**
+	 * @return PRNG period's exponent (2^N) estimation.
+	 */
+
+	static size_t getPeriodExp()
+	{
+		return(( fuse * 8 + fuse * 4 + hcount * 8 ) * sizeof( stype ) -
+			hcount - cs );
+	}
+
+
+protected:
+	stype Seed[ fuse ]; ///< PRNG seeds (>1 - fused).
+	stype lcg[ fuse ]; ///< PRNG lcg (>1 - fused).
+	stype Hash[ hcount ]; ///< PRNG hash array.
+	size_t hpos; ///< Hash array position (increments linearly, resets to 0).
+
+	/**
+	 * Function fills the specified buffer with converted random values, each
+	 * produced from a single getRaw() function's value. PRNG state is kept in
+	 * local variables during the fill, to avoid memory round-trips and
+	 * aliasing with the output buffer.
+	 *
+	 * @param[out] out Output buffer.
+	 * @param n The number of values to produce.
+	 * @tparam otype Output value's type.
+	 * @tparam ctype Converter type, with the static "conv" function.
+	 */
+
+	template< typename otype, typename ctype >
+	void fillConv( otype* out, size_t n )
+	{
+		stype s[ fuse ];
+		stype l[ fuse ];
+		int i;
+
+		for( i = 0; i < fuse; i++ )
+		{
+			s[ i ] = Seed[ i ];
+			l[ i ] = lcg[ i ];
+		}
+
+		if( hcount == 1 && cs == 0 )
+		{
+			// The sole hashword is also kept in a local variable.
+
+			stype h = Hash[ 0 ];
+
+			while( n > 0 )
+			{
+				for( i = 0; i < fuse - 1; i++ )
+				{
+					prvhash_core( s + i, l + i, &h );
+				}
+
+				*out = ctype :: conv( prvhash_core( s + i, l + i, &h ));
+				out++;
+				n--;
+			}
+
+			Hash[ 0 ] = h;
+		}
+		else
+		{
+			size_t hp = hpos;
+
+			while( n > 0 )
+			{
+				stype* h = Hash + hp;
+
+				if( ++hp == hcount )
+				{
+					hp = 0;
+				}
+
+				for( i = 0; i < fuse - 1; i++ )
+				{
+					prvhash_core( s + i, l + i, h );
+				}
+
+				stype res = prvhash_core( s + i, l + i, h );
+
+				int j;
+
+				for( j = 0; j < cs; j++ )
+				{
+					h = Hash + hp;
+
+					if( ++hp == hcount )
+					{
+						hp = 0;
+					}
+
+					for( i = 0; i < fuse - 1; i++ )
+					{
+						prvhash_core( s + i, l + i, h );
+					}
+
+					res ^= prvhash_core( s + i, l + i, h );
+				}
+
+				*out = ctype :: conv( res );
+				out++;
+				n--;
+			}
+
+			hpos = hp;
+		}
+
+		for( i = 0; i < fuse; i++ )
+		{
+			Seed[ i ] = s[ i ];
+			lcg[ i ] = l[ i ];
+		}
+	}
+};
+
+/**
+ * PRVHASH-based PRNG class with the "parallel" arrangement: several
+ * independent PRVHASH systems ("lanes") run interleaved, sharing a common
+ * hashword array. In each round, lane "i" uses hashword "hpos+i", and the
+ * hashword position advances by 1, so that each hashword is daisy-chained
+ * between lanes. Lane states are stored as structure-of-arrays. Provides
+ * the same random number generation functions as the Gradilac class, with
+ * several times higher throughput, but produces different sequences.
+ *
+ * Objects of this class do not use memory allocations and can be placed on
+ * stack (if "hcount" is not large).
+ *
+ * @tparam lanes The number of lanes, must be > 0. 3 lanes are optimal for
+ * 64-bit processors with 16 general-purpose registers.
+ * @tparam hcount The number of hashwords in array, must be larger than
+ * "lanes".
+ * @tparam stype State variable type, must be unsigned integer type, up to 64
+ * bits wide. Using "stype" smaller than 24 bits is not advised.
+ */
+
+template< int lanes = 3, size_t hcount = lanes + 1,
+	typename stype = uint64_t >
+class GradilacPar : public GradilacBase< stype,
+	GradilacPar< lanes, hcount, stype > >
+{
+	friend class GradilacBase< stype, GradilacPar >;
+
+	static_assert( lanes > 0 && hcount > (size_t) lanes,
+		"GradilacPar requires hcount > lanes > 0" );
+
+public:
+	/**
+	 * Constructor. Note that copy-constructor and copy operator remain
+	 * default as class has no complex structures.
+	 *
+	 * @param iseed Initial "small" seed, can be zero.
+	 */
+
+	GradilacPar( const stype iseed = 0 )
+	{
+		seed( iseed );
+	}
+
+	/**
+	 * Function initializes/reinitializes the PRNG. This is not the on-the-go
+	 * re-seeding.
+	 *
+	 * @param iseed Initial "small" seed, can be zero.
+	 */
+
+	void seed( const stype iseed = 0 )
+	{
+		memset( Hash, 0, hcount * sizeof( Hash[ 0 ]));
+
+		// Lanes receive different "lcg" values, to decorrelate their initial
+		// outputs.
+
+		int i;
+
+		for( i = 0; i < lanes; i++ )
+		{
+			Seed[ i ] = iseed;
+			lcg[ i ] = (stype) i;
+		}
+
+		hpos = 0;
+		OutPos = lanes;
+		this -> BitPool = 0;
+		this -> BitsLeft = 0;
+
+		for( i = 0; i < 5; i++ )
+		{
+			round( Out );
+		}
+	}
+
+	/**
+	 * Function re-seeds PRNG on-the-go using a single entropy value. This
+	 * function can be used to efficiently adjust initial seed after the
+	 * default constructor call (iseed=0). Buffered outputs are discarded.
+	 *
+	 * @param ent Entropy value (can be any value).
+	 */
+
+	void reseed( const stype ent )
+	{
+		Seed[ 0 ] ^= ent;
+		lcg[ 0 ] ^= ent;
+
+		mix();
+	}
+
+	/**
+	 * Function re-seeds PRNG, starting from the current state, and using the
+	 * specified data as entropy. Buffered outputs are discarded.
+	 *
+	 * @param data Entropy data block, can be of any length and of any
+	 * statistical quality.
+	 * @param dlen Data length, in bytes.
+	 * @param psize Packet size, in bytes, >= 1. Should not exceed the size of
+	 * "stype". The data will be divided into packets of this size per PRNG
+	 * round.
+	 */
+
+	void reseed( const void* const data, size_t dlen, const size_t psize = 1 )
+	{
+		const uint8_t* d = (const uint8_t*) data;
+
+		while( dlen > 0 )
+		{
+			size_t l = ( psize > dlen ? dlen : psize );
+			dlen -= l;
+			stype p = 0; // Packet.
+
+			while( l > 0 )
+			{
+				p <<= 8;
+				p |= *d;
+
+				d++;
+				l--;
+			}
+
+			Seed[ 0 ] ^= p;
+			lcg[ 0 ] ^= p;
+
+			round( Out );
+		}
+
+		mix();
+	}
+
+	/**
+	 * @return The next random integer number in the "raw", stype-value range.
+	 * Lanes produce values in rounds, values are returned in lane order.
+	 */
+
+	stype getRaw()
+	{
+		if( OutPos == lanes )
+		{
+			round( Out );
+			OutPos = 0;
+		}
+
+		return( Out[ OutPos++ ]);
+	}
+
+	/**
+	 * @return PRNG period's exponent (2^N) estimation.
+	 */
+
+	static size_t getPeriodExp()
+	{
+		return(( lanes * 8 + lanes * 4 + hcount * 8 ) * sizeof( stype ) -
+			hcount );
+	}
+
+protected:
+	stype Seed[ lanes ]; ///< PRNG seeds of lanes.
+	stype lcg[ lanes ]; ///< PRNG lcg of lanes.
+	stype Hash[ hcount ]; ///< PRNG hash array.
+	stype Out[ lanes ]; ///< Outputs of the last round.
+	size_t hpos; ///< Hash array position of lane 0.
+	int OutPos; ///< Position of the next output in Out, == lanes if none.
+
+	/**
+	 * Function performs a PRNG round, with PRNG state kept in the object.
+	 *
+	 * @param[out] o Lane outputs.
+	 */
+
+	void round( stype* const o )
+	{
+		size_t hp = hpos;
+		int i;
+
+		for( i = 0; i < lanes; i++ )
+		{
+			o[ i ] = prvhash_core( Seed + i, lcg + i, Hash + hp );
+
+			if( ++hp == hcount )
+			{
+				hp = 0;
+			}
+		}
+
+		hpos = ( hpos + 1 == hcount ? 0 : hpos + 1 );
+	}
+
+	/**
+	 * Function propagates the input entropy of lane 0 to all lanes, and
+	 * to all hashwords, and discards buffered outputs.
+	 */
+
+	void mix()
+	{
+		size_t i;
+
+		for( i = 0; i < hcount * 2; i++ )
+		{
+			round( Out );
+		}
+
+		OutPos = lanes;
+	}
+
+	/**
+	 * Function fills the specified buffer with converted random values, each
+	 * produced from a single getRaw() function's value. Lane states are kept
+	 * in local variables during the fill. Full passes over the hashword array
+	 * use constant hashword indices, so that a small hashword array can be
+	 * kept in registers as well.
+	 *
+	 * @param[out] out Output buffer.
+	 * @param n The number of values to produce.
+	 * @tparam otype Output value's type.
+	 * @tparam ctype Converter type, with the static "conv" function.
+	 */
+
+	template< typename otype, typename ctype >
+	void fillConv( otype* out, size_t n )
+	{
+		while( n > 0 && OutPos < lanes )
+		{
+			*out = ctype :: conv( Out[ OutPos++ ]);
+			out++;
+			n--;
+		}
+
+		if( n == 0 )
+		{
+			return;
+		}
+
+		static const bool lh = ( hcount <= 16 ); // Use local hashwords.
+		stype hl[ lh ? hcount : 1 ];
+		stype* const ha = ( lh ? hl : Hash );
+		stype s[ lanes ];
+		stype l[ lanes ];
+		size_t hp = hpos;
+		size_t r;
+		int i;
+
+		for( i = 0; i < lanes; i++ )
+		{
+			s[ i ] = Seed[ i ];
+			l[ i ] = lcg[ i ];
+		}
+
+		if( lh )
+		{
+			// Local hashwords are rotated so that "hp" is at index 0.
+
+			for( r = 0; r < hcount; r++ )
+			{
+				hl[ r ] = Hash[ ( hp + r ) % hcount ];
+			}
+		}
+
+		size_t lp = ( lh ? 0 : hp ); // Position of lane 0 in "ha".
+
+		while( n >= lanes )
+		{
+			if( lp == 0 )
+			{
+				while( n >= lanes * hcount )
+				{
+					GRADILAC_UNROLL
+					for( r = 0; r < hcount; r++ )
+					{
+						GRADILAC_UNROLL
+						for( i = 0; i < lanes; i++ )
+						{
+							const size_t j = ( r + i < hcount ? r + i :
+								r + i - hcount );
+
+							out[ i ] = ctype :: conv(
+								prvhash_core( s + i, l + i, ha + j ));
+						}
+
+						out += lanes;
+					}
+
+					n -= lanes * hcount;
+				}
+
+				if( n < lanes )
+				{
+					break;
+				}
+			}
+
+			size_t j = lp;
+
+			for( i = 0; i < lanes; i++ )
+			{
+				out[ i ] = ctype :: conv( prvhash_core( s + i, l + i,
+					ha + j ));
+
+				if( ++j == hcount )
+				{
+					j = 0;
+				}
+			}
+
+			out += lanes;
+			n -= lanes;
+			lp = ( lp + 1 == hcount ? 0 : lp + 1 );
+		}
+
+		for( i = 0; i < lanes; i++ )
+		{
+			Seed[ i ] = s[ i ];
+			lcg[ i ] = l[ i ];
+		}
+
+		if( lh )
+		{
+			for( r = 0; r < hcount; r++ )
+			{
+				Hash[ ( hp + r ) % hcount ] = hl[ r ];
+			}
+
+			hpos = ( hp + lp ) % hcount;
+		}
+		else
+		{
+			hpos = lp;
+		}
+
+		if( n > 0 )
+		{
+			round( Out );
+			OutPos = 0;
+
+			while( n > 0 )
+			{
+				*out = ctype :: conv( Out[ OutPos++ ]);
+				out++;
+				n--;
+			}
+		}
 	}
 };
 
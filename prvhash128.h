@@ -0,0 +1,148 @@
+/**
+ * prvhash128.h version 4.3.0
+ *
+ * The inclusion file for the "prvhash128_128m" and "prvhash128_64m" hash
+ * functions, "minimal" hash functions that use 128-bit state variables and
+ * absorb 16 message bytes per round. Available on compilers that support
+ * the "unsigned __int128" type.
+ *
+ * These functions are experimental: unlike "prvhash64_64m", they were not
+ * validated with the SMHasher suite, and should not be used in its place
+ * until they are.
+ *
+ * Description is available at https://github.com/avaneev/prvhash
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PRVHASH128_INCLUDED
+#define PRVHASH128_INCLUDED
+
+#include "prvhash64.h"
+
+#if defined( __SIZEOF_INT128__ )
+
+#define PRH128_T unsigned __int128 // PRVHASH state variable type.
+#define PRH128_S 16 // State variable type's size.
+#define PRH128_Sm1 ( PRH128_S - 1 ) // = PRH128_S - 1.
+#define PRH128_FN prvhash_core128 // PRVHASH function name.
+#define PRH128_C( h, l ) ( (PRH128_T) (h) << 64 | (l) ) // 128-bit constant.
+
+/**
+ * PRVHASH hash function. Produces and returns a 128-bit hash of the
+ * specified message, string, or binary data block. This is a "minimal"
+ * implementation, similar to the "prvhash64_64m" function, but with 128-bit
+ * state variables: message is read in 16-byte words, as pairs of 64-bit
+ * little-endian words (lower word first), and is padded with the "final
+ * byte" via the prvhash_lpu64ec() function.
+ *
+ * @param Msg0 The message to produce a hash from. The alignment of this
+ * pointer is unimportant.
+ * @param MsgLen Message's length, in bytes.
+ * @param UseSeed Optional value, to use instead of the default seed. To use
+ * the default seed, set to 0. See the "prvhash64_64m" function for details.
+ * @return The hash value; its lower and higher 64-bit halves can be
+ * endianness-corrected and stored in this order, to obtain a 16-byte hash.
+ */
+
+static inline PRH128_T prvhash128_128m( const void* const Msg0,
+	const size_t MsgLen, const uint64_t UseSeed )
+{
+	const uint8_t* Msg = (const uint8_t*) Msg0;
+
+	// The state after 5 PRVHASH rounds from the "zero-state".
+
+	PRH128_T Seed = PRH128_C( 0x420C836EBEC88CA4, 0x76DE487AEF0F46AB );
+	PRH128_T lcg = PRH128_C( 0x8818407FF7BE6E75, 0xB9F400C624C3D59C );
+	PRH128_T Hash = PRH128_C( 0x649EAB70CF6E804A, 0x32C2EB2AA269191B ) ^
+		UseSeed;
+
+	const uint8_t* const MsgEnd = Msg + MsgLen;
+
+	uint64_t fb = 1;
+
+	if( MsgLen != 0 )
+	{
+		fb <<= ( MsgEnd[ -1 ] >> 7 );
+	}
+
+	while( 1 )
+	{
+		PRH128_T msgw;
+
+		if( Msg < MsgEnd - PRH128_Sm1 )
+		{
+			msgw = PRH128_C( prvhash_lu64ec( Msg + 8 ),
+				prvhash_lu64ec( Msg ));
+		}
+		else
+		{
+			if( Msg > MsgEnd )
+			{
+				PRH128_FN( &Seed, &lcg, &Hash );
+
+				return( PRH128_FN( &Seed, &lcg, &Hash ));
+			}
+
+			if( MsgEnd - Msg >= 8 )
+			{
+				msgw = PRH128_C( prvhash_lpu64ec( Msg + 8, MsgEnd, fb ),
+					prvhash_lu64ec( Msg ));
+			}
+			else
+			{
+				msgw = prvhash_lpu64ec( Msg, MsgEnd, fb );
+			}
+		}
+
+		Seed ^= msgw;
+		lcg ^= msgw;
+
+		PRH128_FN( &Seed, &lcg, &Hash );
+
+		Msg += PRH128_S;
+	}
+}
+
+/**
+ * PRVHASH hash function. Produces and returns a 64-bit hash of the specified
+ * message, by folding the "prvhash128_128m" function's 128-bit hash value.
+ *
+ * @param Msg0 The message to produce a hash from. The alignment of this
+ * pointer is unimportant.
+ * @param MsgLen Message's length, in bytes.
+ * @param UseSeed Optional value, to use instead of the default seed. To use
+ * the default seed, set to 0. See the "prvhash64_64m" function for details.
+ */
+
+static inline uint64_t prvhash128_64m( const void* const Msg0,
+	const size_t MsgLen, const uint64_t UseSeed )
+{
+	const PRH128_T h = prvhash128_128m( Msg0, MsgLen, UseSeed );
+
+	return( (uint64_t) ( h ^ h >> 64 ));
+}
+
+#endif // defined( __SIZEOF_INT128__ )
+
+#endif // PRVHASH128_INCLUDED
@@ -1,7 +1,9 @@
 /**
  * prvhash64.h version 4.3.3
  *
- * The inclusion file for the "prvhash64" and "prvhash64_64m" hash functions.
+ * The inclusion file for the "prvhash64" and "prvhash64_64m" hash functions,
+ * including fixed-length, batched and multi-output variants of the
+ * "prvhash64_64m".
  *
  * Description is available at https://github.com/avaneev/prvhash
  *
@@ -250,4 +252,306 @@ static inline uint64_t prvhash64_64m( const void* const Msg0,
 	}
 }
 
+/**
+ * Multi-output variant of the "prvhash64_64m" hash function. Absorbs the
+ * message once, and then produces the specified number of 64-bit hashes,
+ * each by a single additional PRVHASH round. The first hash is equal to the
+ * one returned by the "prvhash64_64m" function for the same message and
+ * seed. This function is meant for probabilistic data structures (Bloom
+ * filters, MinHash sketches) that require several hashes of each key, with
+ * the cost of each additional hash being small and independent of message's
+ * length.
+ *
+ * @param Msg0 The message to produce hashes from. The alignment of this
+ * pointer is unimportant.
+ * @param MsgLen Message's length, in bytes.
+ * @param UseSeed Optional value, to use instead of the default seed. See the
+ * "prvhash64_64m" function for details.
+ * @param[out] HashesOut The resulting hashes, "Count" elements.
+ * @param Count The number of hashes to produce, >= 1.
+ */
+
+static inline void prvhash64_64mk( const void* const Msg0,
+	const size_t MsgLen, const PRH64_T UseSeed, PRH64_T* const HashesOut,
+	const size_t Count )
+{
+	const uint8_t* Msg = (const uint8_t*) Msg0;
+
+	PRH64_T Seed = 0x217992B44669F46A;
+	PRH64_T lcg = 0xB5E2CC2FE9F0B35B;
+	PRH64_T Hash = 0x949B5E0A608D76D5 ^ UseSeed;
+
+	const uint8_t* const MsgEnd = Msg + MsgLen;
+
+	PRH64_T fb = 1;
+
+	if( MsgLen != 0 )
+	{
+		fb <<= ( MsgEnd[ -1 ] >> 7 );
+	}
+
+	while( Msg <= MsgEnd )
+	{
+		const PRH64_T msgw = ( Msg < MsgEnd - PRH64_Sm1 ? PRH64_LUEC( Msg ) :
+			PRH64_LPUEC( Msg, MsgEnd, fb ));
+
+		Seed ^= msgw;
+		lcg ^= msgw;
+
+		PRH64_FN( &Seed, &lcg, &Hash );
+
+		Msg += PRH64_S;
+	}
+
+	PRH64_FN( &Seed, &lcg, &Hash );
+
+	size_t k;
+
+	for( k = 0; k < Count; k++ )
+	{
+		HashesOut[ k ] = PRH64_FN( &Seed, &lcg, &Hash );
+	}
+}
+
+/**
+ * An auxiliary function that implements the "prvhash64_64m" hash function
+ * for messages of a fixed length, in multiples of PRH64_S bytes. When "wc" is
+ * a compile-time constant, the absorption loop is unrolled fully.
+ *
+ * @param Msg The message to produce a hash from, alignment is unimportant.
+ * @param wc Message's length, in PRH64_S-byte words, >= 1.
+ * @param UseSeed Optional value, to use instead of the default seed.
+ */
+
+static PRVHASH_INLINE uint64_t prvhash64_64m_fx( const uint8_t* const Msg,
+	const size_t wc, const PRH64_T UseSeed )
+{
+	PRH64_T Seed = 0x217992B44669F46A; // The state after 5 PRVHASH rounds
+	PRH64_T lcg = 0xB5E2CC2FE9F0B35B; // from the "zero-state".
+	PRH64_T Hash = 0x949B5E0A608D76D5 ^ UseSeed;
+
+	size_t j;
+
+	for( j = 0; j < wc; j++ )
+	{
+		const PRH64_T msgw = PRH64_LUEC( Msg + j * PRH64_S );
+
+		Seed ^= msgw;
+		lcg ^= msgw;
+
+		PRH64_FN( &Seed, &lcg, &Hash );
+	}
+
+	const PRH64_T fb = (PRH64_T) 1 << ( Msg[ wc * PRH64_S - 1 ] >> 7 );
+
+	Seed ^= fb;
+	lcg ^= fb;
+
+	PRH64_FN( &Seed, &lcg, &Hash );
+	PRH64_FN( &Seed, &lcg, &Hash );
+
+	return( PRH64_FN( &Seed, &lcg, &Hash ));
+}
+
+/**
+ * Fixed-length variants of the "prvhash64_64m" hash function, for 4-, 8-,
+ * 16-, and 32-byte messages (e.g., integer keys and UUIDs). These functions
+ * return hashes equal to the "prvhash64_64m" function's, but do not use
+ * length-dependent branching.
+ *
+ * @param Msg0 The message to produce a hash from. The alignment of this
+ * pointer is unimportant.
+ * @param UseSeed Optional value, to use instead of the default seed. See the
+ * "prvhash64_64m" function for details.
+ */
+
+static inline uint64_t prvhash64_64m_4( const void* const Msg0,
+	const PRH64_T UseSeed )
+{
+	const uint8_t* const Msg = (const uint8_t*) Msg0;
+
+	PRH64_T Seed = 0x217992B44669F46A;
+	PRH64_T lcg = 0xB5E2CC2FE9F0B35B;
+	PRH64_T Hash = 0x949B5E0A608D76D5 ^ UseSeed;
+
+	const PRH64_T fb = (PRH64_T) 1 << ( Msg[ 3 ] >> 7 );
+	const PRH64_T msgw = fb << 32 | prvhash_lu32ec( Msg );
+
+	Seed ^= msgw;
+	lcg ^= msgw;
+
+	PRH64_FN( &Seed, &lcg, &Hash );
+	PRH64_FN( &Seed, &lcg, &Hash );
+
+	return( PRH64_FN( &Seed, &lcg, &Hash ));
+}
+
+static inline uint64_t prvhash64_64m_8( const void* const Msg0,
+	const PRH64_T UseSeed )
+{
+	return( prvhash64_64m_fx( (const uint8_t*) Msg0, 1, UseSeed ));
+}
+
+static inline uint64_t prvhash64_64m_16( const void* const Msg0,
+	const PRH64_T UseSeed )
+{
+	return( prvhash64_64m_fx( (const uint8_t*) Msg0, 2, UseSeed ));
+}
+
+static inline uint64_t prvhash64_64m_32( const void* const Msg0,
+	const PRH64_T UseSeed )
+{
+	return( prvhash64_64m_fx( (const uint8_t*) Msg0, 4, UseSeed ));
+}
+
+/**
+ * An auxiliary function that finishes the "prvhash64_64m" hashing of a
+ * message, starting at the specified message word. Used by the
+ * "prvhash64_64m_batch" function.
+ *
+ * @param Msg Message pointer, alignment is unimportant.
+ * @param MsgLen Message's length, in bytes.
+ * @param j Index of the next message word to absorb, should not exceed
+ * MsgLen / PRH64_S.
+ * @param[in,out] Seed0 The current "Seed" value.
+ * @param[in,out] lcg0 The current "lcg" value.
+ * @param[in,out] Hash0 The current hash word.
+ * @return The resulting hash.
+ */
+
+static PRVHASH_INLINE PRH64_T prvhash64_64m_tail( const uint8_t* const Msg,
+	const size_t MsgLen, size_t j, PRH64_T* const Seed0,
+	PRH64_T* const lcg0, PRH64_T* const Hash0 )
+{
+	PRH64_T Seed = *Seed0; PRH64_T lcg = *lcg0; PRH64_T Hash = *Hash0;
+	const size_t wc = MsgLen / PRH64_S;
+
+	for( ; j < wc; j++ )
+	{
+		const PRH64_T msgw = PRH64_LUEC( Msg + j * PRH64_S );
+
+		Seed ^= msgw;
+		lcg ^= msgw;
+
+		PRH64_FN( &Seed, &lcg, &Hash );
+	}
+
+	PRH64_T fb = 1;
+
+	if( MsgLen != 0 )
+	{
+		fb <<= ( Msg[ MsgLen - 1 ] >> 7 );
+	}
+
+	const PRH64_T msgw = PRH64_LPUEC( Msg + wc * PRH64_S, Msg + MsgLen, fb );
+
+	Seed ^= msgw;
+	lcg ^= msgw;
+
+	PRH64_FN( &Seed, &lcg, &Hash );
+	PRH64_FN( &Seed, &lcg, &Hash );
+
+	return( PRH64_FN( &Seed, &lcg, &Hash ));
+}
+
+/**
+ * Batched variant of the "prvhash64_64m" hash function. Produces 64-bit
+ * hashes of several messages in a single call; each resulting hash is equal
+ * to the one returned by the "prvhash64_64m" function for the same message
+ * and seed. Messages are processed in groups of 4, with rounds of the
+ * messages in a group being interleaved, so that their dependency chains
+ * overlap. The highest efficiency is achieved when messages in a group have
+ * similar lengths.
+ *
+ * @param Msgs Pointers to messages, "Count" elements. The alignment of
+ * message pointers is unimportant.
+ * @param MsgLens Messages' lengths, in bytes, "Count" elements.
+ * @param UseSeeds Optional seeds, "Count" elements, see the "prvhash64_64m"
+ * function for details. To use the default seed for all messages, set to 0.
+ * @param[out] HashesOut The resulting hashes, "Count" elements.
+ * @param Count The number of messages to hash.
+ */
+
+static inline void prvhash64_64m_batch( const void* const* const Msgs,
+	const size_t* const MsgLens, const PRH64_T* const UseSeeds,
+	PRH64_T* const HashesOut, const size_t Count )
+{
+	size_t k;
+
+	for( k = 0; k + 4 <= Count; k += 4 )
+	{
+		const uint8_t* const Msg1 = (const uint8_t*) Msgs[ k ];
+		const uint8_t* const Msg2 = (const uint8_t*) Msgs[ k + 1 ];
+		const uint8_t* const Msg3 = (const uint8_t*) Msgs[ k + 2 ];
+		const uint8_t* const Msg4 = (const uint8_t*) Msgs[ k + 3 ];
+		const size_t wc1 = MsgLens[ k ] / PRH64_S;
+		const size_t wc2 = MsgLens[ k + 1 ] / PRH64_S;
+		const size_t wc3 = MsgLens[ k + 2 ] / PRH64_S;
+		const size_t wc4 = MsgLens[ k + 3 ] / PRH64_S;
+
+		PRH64_T Seed1 = 0x217992B44669F46A;
+		PRH64_T Seed2 = Seed1, Seed3 = Seed1, Seed4 = Seed1;
+		PRH64_T lcg1 = 0xB5E2CC2FE9F0B35B;
+		PRH64_T lcg2 = lcg1, lcg3 = lcg1, lcg4 = lcg1;
+		PRH64_T Hash1 = 0x949B5E0A608D76D5;
+		PRH64_T Hash2 = Hash1, Hash3 = Hash1, Hash4 = Hash1;
+
+		if( UseSeeds != 0 )
+		{
+			Hash1 ^= UseSeeds[ k ];
+			Hash2 ^= UseSeeds[ k + 1 ];
+			Hash3 ^= UseSeeds[ k + 2 ];
+			Hash4 ^= UseSeeds[ k + 3 ];
+		}
+
+		size_t wc = wc1;
+		wc = ( wc2 < wc ? wc2 : wc );
+		wc = ( wc3 < wc ? wc3 : wc );
+		wc = ( wc4 < wc ? wc4 : wc );
+
+		size_t j;
+
+		for( j = 0; j < wc; j++ )
+		{
+			const size_t o = j * PRH64_S;
+			const PRH64_T m1 = PRH64_LUEC( Msg1 + o );
+			const PRH64_T m2 = PRH64_LUEC( Msg2 + o );
+			const PRH64_T m3 = PRH64_LUEC( Msg3 + o );
+			const PRH64_T m4 = PRH64_LUEC( Msg4 + o );
+
+			Seed1 ^= m1;
+			lcg1 ^= m1;
+			Seed2 ^= m2;
+			lcg2 ^= m2;
+			Seed3 ^= m3;
+			lcg3 ^= m3;
+			Seed4 ^= m4;
+			lcg4 ^= m4;
+
+			PRH64_FN( &Seed1, &lcg1, &Hash1 );
+			PRH64_FN( &Seed2, &lcg2, &Hash2 );
+			PRH64_FN( &Seed3, &lcg3, &Hash3 );
+			PRH64_FN( &Seed4, &lcg4, &Hash4 );
+		}
+
+		HashesOut[ k ] = prvhash64_64m_tail( Msg1, MsgLens[ k ], wc,
+			&Seed1, &lcg1, &Hash1 );
+
+		HashesOut[ k + 1 ] = prvhash64_64m_tail( Msg2, MsgLens[ k + 1 ], wc,
+			&Seed2, &lcg2, &Hash2 );
+
+		HashesOut[ k + 2 ] = prvhash64_64m_tail( Msg3, MsgLens[ k + 2 ], wc,
+			&Seed3, &lcg3, &Hash3 );
+
+		HashesOut[ k + 3 ] = prvhash64_64m_tail( Msg4, MsgLens[ k + 3 ], wc,
+			&Seed4, &lcg4, &Hash4 );
+	}
+
+	for( ; k < Count; k++ )
+	{
+		HashesOut[ k ] = prvhash64_64m( Msgs[ k ], MsgLens[ k ],
+			( UseSeeds == 0 ? 0 : UseSeeds[ k ]));
+	}
+}
+
 #endif // PRVHASH64_INCLUDED
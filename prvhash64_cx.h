@@ -0,0 +1,168 @@
+/**
+ * prvhash64_cx.h version 4.3.0
+ *
+ * The inclusion file for the C++ "constexpr" implementation of the
+ * "prvhash64_64m" hash function, for compile-time hashing of string literals
+ * and keys, including the "_prvh" user-defined literal. Produces hashes equal
+ * to the "prvhash64_64m" function's. Standalone, does not require PRVHASH
+ * header files. Requires C++14.
+ *
+ * Description is available at https://github.com/avaneev/prvhash
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PRVHASH64_CX_INCLUDED
+#define PRVHASH64_CX_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if __cplusplus >= 201703L || ( defined( _MSVC_LANG ) && _MSVC_LANG >= 201703L )
+	#include <string_view>
+#endif // __cplusplus >= 201703L
+
+/**
+ * "constexpr" PRVHASH core function. For more information, please refer to
+ * the "prvhash_core64" function in the "prvhash_core.h" file.
+ *
+ * @param[in,out] Seed The current "Seed" value.
+ * @param[in,out] lcg The current "lcg" value.
+ * @param[in,out] Hash Current hash word.
+ * @return Current random value.
+ */
+
+constexpr uint64_t prvhash_core64_cx( uint64_t& Seed, uint64_t& lcg,
+	uint64_t& Hash )
+{
+	Seed *= lcg * 2 + 1;
+	const uint64_t rs = Seed >> 32 | Seed << 32;
+	Hash += rs + 0xAAAAAAAAAAAAAAAA;
+	lcg += Seed + 0x5555555555555555;
+	Seed ^= Hash;
+
+	return( lcg ^ rs );
+}
+
+/**
+ * "constexpr" function that loads a little-endian 64-bit value from the
+ * specified message bytes, and pads it with the "final byte", like the
+ * "prvhash_lu64ec" and "prvhash_lpu64ec" functions do.
+ *
+ * @param Msg Message's bytes.
+ * @param l The number of bytes to load, 0 to 8.
+ * @param fb Final byte used for padding, used if l < 8.
+ */
+
+template< typename ctype >
+constexpr uint64_t prvhash_lpu64_cx( const ctype* const Msg, const size_t l,
+	const uint64_t fb )
+{
+	uint64_t v = ( l < 8 ? fb << ( l * 8 ) : 0 );
+
+	for( size_t i = 0; i < l; i++ )
+	{
+		v |= (uint64_t) (uint8_t) Msg[ i ] << ( i * 8 );
+	}
+
+	return( v );
+}
+
+/**
+ * "constexpr" variant of the "prvhash64_64m" hash function. Produces a hash
+ * value equal to the "prvhash64_64m" function's hash of the same bytes, on
+ * little- and big-endian systems.
+ *
+ * @param Msg The message to produce a hash from, with "char", "signed char",
+ * "unsigned char", or "uint8_t" elements.
+ * @param MsgLen Message's length, in elements (bytes).
+ * @param UseSeed Optional value, to use instead of the default seed. To use
+ * the default seed, set to 0. See the "prvhash64_64m" function for details.
+ */
+
+template< typename ctype >
+constexpr uint64_t prvhash64_64m_cx( const ctype* const Msg,
+	const size_t MsgLen, const uint64_t UseSeed = 0 )
+{
+	static_assert( sizeof( ctype ) == 1, "Byte-sized elements are required" );
+
+	uint64_t Seed = 0x217992B44669F46A; // The state after 5 PRVHASH rounds
+	uint64_t lcg = 0xB5E2CC2FE9F0B35B; // from the "zero-state".
+	uint64_t Hash = 0x949B5E0A608D76D5 ^ UseSeed;
+
+	const uint64_t fb = ( MsgLen == 0 ? 1 :
+		(uint64_t) 1 << ( (uint8_t) Msg[ MsgLen - 1 ] >> 7 ));
+
+	size_t i = 0;
+
+	while( i <= MsgLen )
+	{
+		const size_t l = ( MsgLen - i > 8 ? 8 : MsgLen - i );
+		const uint64_t msgw = prvhash_lpu64_cx( Msg + i, l, fb );
+
+		Seed ^= msgw;
+		lcg ^= msgw;
+
+		prvhash_core64_cx( Seed, lcg, Hash );
+
+		i += 8;
+	}
+
+	prvhash_core64_cx( Seed, lcg, Hash );
+
+	return( prvhash_core64_cx( Seed, lcg, Hash ));
+}
+
+#if __cplusplus >= 201703L || ( defined( _MSVC_LANG ) && _MSVC_LANG >= 201703L )
+
+/**
+ * "constexpr" variant of the "prvhash64_64m" hash function, for string
+ * views.
+ *
+ * @param s String to produce a hash from.
+ * @param UseSeed Optional value, to use instead of the default seed.
+ */
+
+constexpr uint64_t prvhash64_64m_cx( const std :: string_view s,
+	const uint64_t UseSeed = 0 )
+{
+	return( prvhash64_64m_cx( s.data(), s.size(), UseSeed ));
+}
+
+#endif // __cplusplus >= 201703L
+
+/**
+ * User-defined literal that returns the "prvhash64_64m" hash of a string
+ * literal, excluding its terminating zero, with the default seed. Can be
+ * used as a "case" label, e.g., "case "key"_prvh:".
+ *
+ * @param s String literal.
+ * @param l String literal's length.
+ */
+
+constexpr uint64_t operator "" _prvh( const char* const s, const size_t l )
+{
+	return( prvhash64_64m_cx( s, l, 0 ));
+}
+
+#endif // PRVHASH64_CX_INCLUDED
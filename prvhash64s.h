@@ -33,7 +33,7 @@
 #ifndef PRVHASH64S_INCLUDED
 #define PRVHASH64S_INCLUDED
 
-#include "prvhash_core.h"
+#include "prvhash64.h"
 
 #define PRH64S_T uint64_t // PRVHASH state variable type.
 #define PRH64S_S sizeof( PRH64S_T ) // State variable type's size.
@@ -267,6 +267,144 @@ static inline void prvhash64s_update( PRVHASH64S_CTX* const ctx,
 	ctx -> fb = Msg[ MsgLen - 1 ];
 }
 
+/**
+ * Message buffer descriptor for the prvhash64s_updatev() function, similar
+ * to the "iovec" structure.
+ */
+
+typedef struct {
+	const void* Msg; ///< Message buffer, alignment is unimportant.
+	size_t MsgLen; ///< Message buffer's length, in bytes; can be 0.
+} PRVHASH64S_VEC;
+
+/**
+ * An auxiliary function that absorbs a single PRH64S_LEN-byte block into the
+ * fused state, and advances the hashword pointer.
+ *
+ * @param[in,out] Seed Fused "Seed" values.
+ * @param[in,out] lcg Fused "lcg" values.
+ * @param[in,out] hc Hashword pointer.
+ * @param Hash Hash buffer's start.
+ * @param HashEnd Hash buffer's end.
+ * @param Msg Block's data, alignment is unimportant.
+ */
+
+static PRVHASH_INLINE void prvhash64s_block( PRH64S_T* const Seed,
+	PRH64S_T* const lcg, PRH64S_T** const hc, uint8_t* const Hash,
+	const PRH64S_T* const HashEnd, const uint8_t* const Msg )
+{
+	const PRH64S_T m1 = PRH64S_LUEC( Msg );
+	const PRH64S_T m2 = PRH64S_LUEC( Msg + PRH64S_S );
+	const PRH64S_T m3 = PRH64S_LUEC( Msg + PRH64S_S * 2 );
+	const PRH64S_T m4 = PRH64S_LUEC( Msg + PRH64S_S * 3 );
+
+	Seed[ 0 ] ^= m1;
+	lcg[ 0 ] ^= m1;
+	Seed[ 1 ] ^= m2;
+	lcg[ 1 ] ^= m2;
+	Seed[ 2 ] ^= m3;
+	lcg[ 2 ] ^= m3;
+	Seed[ 3 ] ^= m4;
+	lcg[ 3 ] ^= m4;
+
+	PRH64S_FN( &Seed[ 0 ], &lcg[ 0 ], *hc );
+	PRH64S_FN( &Seed[ 1 ], &lcg[ 1 ], *hc );
+	PRH64S_FN( &Seed[ 2 ], &lcg[ 2 ], *hc );
+	PRH64S_FN( &Seed[ 3 ], &lcg[ 3 ], *hc );
+
+	if( ++*hc == HashEnd )
+	{
+		*hc = (PRH64S_T*) Hash;
+	}
+}
+
+/**
+ * This function updates the hash according to the contents of several
+ * message buffers (scatter/gather update). The result is equal to calling
+ * the prvhash64s_update() function for each buffer in order, but the fused
+ * state is kept in local variables during the whole call: it is loaded from
+ * and stored to the context structure only once. Block boundaries between
+ * buffers are stitched in-place in the context's intermediate block.
+ *
+ * @param[in,out] ctx Context structure.
+ * @param Vecs Message buffer descriptors, "VecCount" elements.
+ * @param VecCount The number of message buffers; can be 0.
+ */
+
+static inline void prvhash64s_updatev( PRVHASH64S_CTX* const ctx,
+	const PRVHASH64S_VEC* const Vecs, const size_t VecCount )
+{
+	const PRH64S_T* const HashEnd =
+		(PRH64S_T*) ( ctx -> Hash + ctx -> HashLen );
+
+	PRH64S_T* hc = (PRH64S_T*) ( ctx -> Hash + ctx -> HashPos );
+	PRH64S_T Seed[ PRH64S_FUSE ];
+	PRH64S_T lcg[ PRH64S_FUSE ];
+	uint8_t* const blk = ctx -> Block;
+	size_t blf = ctx -> BlockFill;
+	size_t i;
+
+	memcpy( Seed, ctx -> Seed, sizeof( Seed ));
+	memcpy( lcg, ctx -> lcg, sizeof( lcg ));
+
+	for( i = 0; i < VecCount; i++ )
+	{
+		const uint8_t* Msg = (const uint8_t*) Vecs[ i ].Msg;
+		size_t MsgLen = Vecs[ i ].MsgLen;
+
+		if( MsgLen == 0 )
+		{
+			continue;
+		}
+
+		if( blf != 0 )
+		{
+			size_t CopyLen = PRH64S_LEN - blf;
+			CopyLen = ( CopyLen > MsgLen ? MsgLen : CopyLen );
+
+			memcpy( blk + blf, Msg, CopyLen );
+			blf += CopyLen;
+			Msg += CopyLen;
+			MsgLen -= CopyLen;
+
+			if( blf != PRH64S_LEN )
+			{
+				continue;
+			}
+
+			prvhash64s_block( Seed, lcg, &hc, ctx -> Hash, HashEnd, blk );
+			blf = 0;
+		}
+
+		while( MsgLen >= PRH64S_LEN )
+		{
+			prvhash64s_block( Seed, lcg, &hc, ctx -> Hash, HashEnd, Msg );
+
+			Msg += PRH64S_LEN;
+			MsgLen -= PRH64S_LEN;
+		}
+
+		memcpy( blk, Msg, MsgLen );
+		blf = MsgLen;
+	}
+
+	memcpy( ctx -> Seed, Seed, sizeof( Seed ));
+	memcpy( ctx -> lcg, lcg, sizeof( lcg ));
+	ctx -> HashPos = (uint8_t*) hc - ctx -> Hash;
+	ctx -> BlockFill = blf;
+
+	for( i = 0; i < VecCount; i++ )
+	{
+		const size_t MsgLen = Vecs[ i ].MsgLen;
+
+		if( MsgLen != 0 )
+		{
+			ctx -> MsgLen += (uint64_t) MsgLen;
+			ctx -> fb = ( (const uint8_t*) Vecs[ i ].Msg )[ MsgLen - 1 ];
+		}
+	}
+}
+
 /**
  * This function finalizes the streamed hashing. This function should be
  * called only after a prior prvhash64s_init() function call; intermediate
@@ -384,4 +522,163 @@ static inline void prvhash64s_oneshot( const void* const Msg,
 	prvhash64s_final( &ctx, Hash );
 }
 
+#define PRH64S_STATE_VER 1 // Exported state's format version.
+#define PRH64S_STATE_HDR 80 // Exported state's fixed header length.
+#define PRH64S_STATE_MAX ( PRH64S_STATE_HDR + PRH64S_MAX + \
+	PRH64S_LEN + 8 ) // Maximal length of the exported state, in bytes.
+
+/**
+ * This function returns the length of the exported streaming state, in
+ * bytes. The length includes HashLen bytes of the hash buffer, the filled
+ * part of the intermediate block, and an 8-byte integrity check value.
+ *
+ * @param[in] ctx Context structure.
+ */
+
+static inline size_t prvhash64s_state_len( const PRVHASH64S_CTX* const ctx )
+{
+	return( PRH64S_STATE_HDR + ctx -> HashLen + ctx -> BlockFill + 8 );
+}
+
+/**
+ * This function exports the streaming state of the context structure into a
+ * compact byte buffer, to be later restored via the prvhash64s_import()
+ * function, possibly on a system with a different endianness. Can be called
+ * at any point between the prvhash64s_init() and prvhash64s_final() calls;
+ * the context structure remains unchanged.
+ *
+ * All values are stored in little-endian order: 4-byte tag "PHS" plus format
+ * version, HashLen / PRH64S_S, HashPos / PRH64S_S, BlockFill and fb bytes,
+ * 8-byte MsgLen, Seed and lcg values, HashLen bytes of the hash buffer,
+ * BlockFill bytes of the intermediate block, and the "prvhash64_64m" hash of
+ * the preceding bytes.
+ *
+ * @param[in] ctx Context structure.
+ * @param[out] Buf The buffer to receive the state, at least
+ * prvhash64s_state_len() bytes long, or PRH64S_STATE_MAX bytes long. The
+ * address alignment of this buffer is unimportant.
+ * @return The number of bytes written to the Buf.
+ */
+
+static inline size_t prvhash64s_export( const PRVHASH64S_CTX* const ctx,
+	void* const Buf )
+{
+	uint8_t* const b = (uint8_t*) Buf;
+	uint64_t v;
+	size_t k;
+	int i;
+
+	b[ 0 ] = 'P';
+	b[ 1 ] = 'H';
+	b[ 2 ] = 'S';
+	b[ 3 ] = PRH64S_STATE_VER;
+	b[ 4 ] = (uint8_t) ( ctx -> HashLen / PRH64S_S );
+	b[ 5 ] = (uint8_t) ( ctx -> HashPos / PRH64S_S );
+	b[ 6 ] = (uint8_t) ctx -> BlockFill;
+	b[ 7 ] = ctx -> fb;
+
+	v = PRH64S_EC( ctx -> MsgLen );
+	memcpy( b + 8, &v, 8 );
+
+	for( i = 0; i < PRH64S_FUSE; i++ )
+	{
+		v = PRH64S_EC( ctx -> Seed[ i ]);
+		memcpy( b + 16 + i * PRH64S_S, &v, PRH64S_S );
+		v = PRH64S_EC( ctx -> lcg[ i ]);
+		memcpy( b + 48 + i * PRH64S_S, &v, PRH64S_S );
+	}
+
+	uint8_t* p = b + PRH64S_STATE_HDR;
+
+	for( k = 0; k < ctx -> HashLen; k += PRH64S_S )
+	{
+		PRH64S_T hv;
+		memcpy( &hv, ctx -> Hash + k, PRH64S_S );
+		hv = PRH64S_EC( hv );
+		memcpy( p + k, &hv, PRH64S_S );
+	}
+
+	p += ctx -> HashLen;
+	memcpy( p, ctx -> Block, ctx -> BlockFill );
+	p += ctx -> BlockFill;
+
+	v = PRVHASH_EC64( prvhash64_64m( b, (size_t) ( p - b ), 0 ));
+	memcpy( p, &v, 8 );
+
+	return( (size_t) ( p - b ) + 8 );
+}
+
+/**
+ * This function restores the streaming state previously exported via the
+ * prvhash64s_export() function. After a successful import, hashing can be
+ * continued via the prvhash64s_update() and prvhash64s_final() functions,
+ * producing the same hash as an uninterrupted session would. The
+ * prvhash64s_init() function should not be called on the context.
+ *
+ * @param[out] ctx Context structure. Should be aligned to PRH64S_S bytes.
+ * @param Buf The buffer containing the exported state. The address alignment
+ * of this buffer is unimportant.
+ * @param BufLen The length of the Buf, in bytes; can exceed the length of
+ * the exported state.
+ * @return 0 if the Buf is too short, or its contents are not a valid state
+ * of a supported version; the context remains unchanged in this case.
+ */
+
+static inline int prvhash64s_import( PRVHASH64S_CTX* const ctx,
+	const void* const Buf, const size_t BufLen )
+{
+	const uint8_t* const b = (const uint8_t*) Buf;
+
+	if( BufLen < PRH64S_STATE_HDR || b[ 0 ] != 'P' || b[ 1 ] != 'H' ||
+		b[ 2 ] != 'S' || b[ 3 ] != PRH64S_STATE_VER )
+	{
+		return( 0 );
+	}
+
+	const size_t HashLen = (size_t) b[ 4 ] * PRH64S_S;
+	const size_t HashPos = (size_t) b[ 5 ] * PRH64S_S;
+	const size_t BlockFill = b[ 6 ];
+
+	if( HashLen == 0 || HashLen > PRH64S_MAX || HashPos >= HashLen ||
+		BlockFill >= PRH64S_LEN )
+	{
+		return( 0 );
+	}
+
+	const size_t l = PRH64S_STATE_HDR + HashLen + BlockFill;
+
+	if( BufLen < l + 8 ||
+		prvhash64_64m( b, l, 0 ) != prvhash_lu64ec( b + l ))
+	{
+		return( 0 );
+	}
+
+	size_t k;
+	int i;
+
+	for( i = 0; i < PRH64S_FUSE; i++ )
+	{
+		ctx -> Seed[ i ] = PRH64S_LUEC( b + 16 + i * PRH64S_S );
+		ctx -> lcg[ i ] = PRH64S_LUEC( b + 48 + i * PRH64S_S );
+	}
+
+	const uint8_t* const p = b + PRH64S_STATE_HDR;
+
+	for( k = 0; k < HashLen; k += PRH64S_S )
+	{
+		const PRH64S_T hv = PRH64S_LUEC( p + k );
+		memcpy( ctx -> Hash + k, &hv, PRH64S_S );
+	}
+
+	memcpy( ctx -> Block, p + HashLen, BlockFill );
+
+	ctx -> MsgLen = prvhash_lu64ec( b + 8 );
+	ctx -> HashLen = HashLen;
+	ctx -> HashPos = HashPos;
+	ctx -> BlockFill = BlockFill;
+	ctx -> fb = b[ 7 ];
+
+	return( 1 );
+}
+
 #endif // PRVHASH64S_INCLUDED
@@ -0,0 +1,244 @@
+/**
+ * prvhash64s_file.h version 4.3.0
+ *
+ * The inclusion file for the "prvhash64s_file" function that calculates the
+ * "prvhash64s" hash of a file. On Unix systems, large files are hashed via
+ * memory-mapping with sequential access hints, smaller files via large
+ * buffered reads. On other systems, standard C file functions are used.
+ *
+ * Description is available at https://github.com/avaneev/prvhash
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PRVHASH64S_FILE_INCLUDED
+#define PRVHASH64S_FILE_INCLUDED
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if !defined( _WIN32 )
+
+	#include <errno.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+
+	#define PRH64SF_UNIX 1
+
+#endif // !defined( _WIN32 )
+
+#include "prvhash64s.h"
+
+#define PRH64SF_BUF ( 1 << 20 ) // Read buffer's length, in bytes.
+#define PRH64SF_MMAP_MIN ( 1 << 22 ) // Minimal file length for mmap use.
+#define PRH64SF_MMAP_STEP ( 1 << 26 ) // Hashed portion of mapped file.
+
+#if defined( PRH64SF_UNIX )
+
+/**
+ * An auxiliary function that hashes a file via memory-mapping.
+ *
+ * @param[in,out] ctx Initialized context structure.
+ * @param fd File descriptor.
+ * @param fl File's length, in bytes, > 0.
+ * @return 0 if mapping failed; the context remains unchanged in this case.
+ */
+
+static inline int prvhash64s_file_mmap( PRVHASH64S_CTX* const ctx,
+	const int fd, const size_t fl )
+{
+	uint8_t* const p = (uint8_t*) mmap( 0, fl, PROT_READ, MAP_PRIVATE, fd,
+		0 );
+
+	if( p == (uint8_t*) MAP_FAILED )
+	{
+		return( 0 );
+	}
+
+	// The madvise() hints are unavailable in strict ISO C builds.
+
+	#if defined( MADV_SEQUENTIAL )
+		madvise( p, fl, MADV_SEQUENTIAL );
+	#endif // defined( MADV_SEQUENTIAL )
+
+	#if defined( MADV_HUGEPAGE )
+		madvise( p, fl, MADV_HUGEPAGE );
+	#endif // defined( MADV_HUGEPAGE )
+
+	size_t o = 0;
+
+	while( o < fl )
+	{
+		const size_t l = ( fl - o > PRH64SF_MMAP_STEP ?
+			PRH64SF_MMAP_STEP : fl - o );
+
+		// Prefetch the next portion while the current one is being hashed,
+		// and release the pages of the hashed portion.
+
+		#if defined( MADV_WILLNEED )
+
+			if( o + l < fl )
+			{
+				const size_t nl = ( fl - o - l > PRH64SF_MMAP_STEP ?
+					PRH64SF_MMAP_STEP : fl - o - l );
+
+				madvise( p + o + l, nl, MADV_WILLNEED );
+			}
+
+		#endif // defined( MADV_WILLNEED )
+
+		prvhash64s_update( ctx, p + o, l );
+
+		#if defined( MADV_DONTNEED )
+			madvise( p + o, l, MADV_DONTNEED );
+		#endif // defined( MADV_DONTNEED )
+
+		o += l;
+	}
+
+	munmap( p, fl );
+
+	return( 1 );
+}
+
+#endif // defined( PRH64SF_UNIX )
+
+/**
+ * This function calculates the "prvhash64s" hash of the specified file, with
+ * default seed settings. The resulting hash is equal to the
+ * prvhash64s_oneshot() function's hash of the whole file's contents.
+ *
+ * @param FileName The path to the file.
+ * @param[out] Hash The hash buffer, length = HashLen. The address alignment
+ * of this buffer is unimportant.
+ * @param HashLen The required hash length, in bytes; should be >= PRH64S_S,
+ * in increments of PRH64S_S. Should not exceed PRH64S_MAX.
+ * @return 0 if the file cannot be opened or read.
+ */
+
+static inline int prvhash64s_file( const char* const FileName,
+	void* const Hash, const size_t HashLen )
+{
+	PRVHASH64S_CTX ctx;
+	prvhash64s_init( &ctx, HashLen, 0 );
+
+	uint8_t* buf;
+	int res = 1;
+
+	#if defined( PRH64SF_UNIX )
+
+		const int fd = open( FileName, O_RDONLY );
+
+		if( fd < 0 )
+		{
+			return( 0 );
+		}
+
+		struct stat st;
+
+		if( fstat( fd, &st ) == 0 && S_ISREG( st.st_mode ) &&
+			st.st_size >= PRH64SF_MMAP_MIN &&
+			(uint64_t) st.st_size <= (uint64_t) (size_t) -1 &&
+			prvhash64s_file_mmap( &ctx, fd, (size_t) st.st_size ))
+		{
+			close( fd );
+			prvhash64s_final( &ctx, Hash );
+
+			return( 1 );
+		}
+
+		#if defined( POSIX_FADV_SEQUENTIAL )
+			posix_fadvise( fd, 0, 0, POSIX_FADV_SEQUENTIAL );
+		#endif // defined( POSIX_FADV_SEQUENTIAL )
+
+		buf = (uint8_t*) malloc( PRH64SF_BUF );
+
+		if( buf == 0 )
+		{
+			close( fd );
+			return( 0 );
+		}
+
+		while( 1 )
+		{
+			const ssize_t l = read( fd, buf, PRH64SF_BUF );
+
+			if( l < 0 && errno == EINTR )
+			{
+				continue; // Interrupted by a signal, retry.
+			}
+
+			if( l <= 0 )
+			{
+				res = ( l == 0 );
+				break;
+			}
+
+			prvhash64s_update( &ctx, buf, (size_t) l );
+		}
+
+		close( fd );
+
+	#else // defined( PRH64SF_UNIX )
+
+		FILE* const f = fopen( FileName, "rb" );
+
+		if( f == 0 )
+		{
+			return( 0 );
+		}
+
+		buf = (uint8_t*) malloc( PRH64SF_BUF );
+
+		if( buf == 0 )
+		{
+			fclose( f );
+			return( 0 );
+		}
+
+		while( 1 )
+		{
+			const size_t l = fread( buf, 1, PRH64SF_BUF, f );
+
+			if( l == 0 )
+			{
+				res = !ferror( f );
+				break;
+			}
+
+			prvhash64s_update( &ctx, buf, l );
+		}
+
+		fclose( f );
+
+	#endif // defined( PRH64SF_UNIX )
+
+	free( buf );
+	prvhash64s_final( &ctx, Hash );
+
+	return( res );
+}
+
+#endif // PRVHASH64S_FILE_INCLUDED
@@ -0,0 +1,398 @@
+/**
+ * prvhash64s_tree.h version 4.3.0
+ *
+ * The inclusion file for the "prvhash64s_tree" hash function, a tree-mode
+ * (parallel) variant of the "prvhash64s" streamed hash function. The message
+ * is split into PRH64ST_CHUNK-byte chunks, each chunk is hashed independently
+ * with the "prvhash64s" function, and chunk digests are then hashed by the
+ * root "prvhash64s" hashing session. Chunks can be hashed concurrently, so
+ * that throughput scales with the number of processor cores.
+ *
+ * Note that this is a separate hash function: it produces hash values that
+ * are different to the "prvhash64s" hash function.
+ *
+ * Description is available at https://github.com/avaneev/prvhash
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PRVHASH64S_TREE_INCLUDED
+#define PRVHASH64S_TREE_INCLUDED
+
+#include <stdlib.h>
+#include "prvhash64s.h"
+#include "prvhash_thread.h"
+
+#define PRH64ST_CHUNK 65536 // Chunk length, in bytes.
+#define PRH64ST_SEEDS ( PRH64S_S * PRH64S_FUSE ) // Seed pool's length.
+#define PRH64ST_LEAF 0x6C65616674726565 // Leaf session's seed mark.
+#define PRH64ST_ROOT 0x726F6F7474726565 // Root session's seed mark.
+
+/**
+ * The context structure of the "prvhash64s_tree_X" functions. On systems
+ * where this is relevant, this structure should be aligned to PRH64S_S
+ * bytes. This structure is relatively large, and should not be placed on a
+ * limited stack.
+ */
+
+typedef struct {
+	PRVHASH64S_CTX Leaf; ///< Current chunk's hashing session.
+	PRVHASH64S_CTX Root; ///< Root hashing session.
+	uint8_t Seeds[ PRH64ST_SEEDS ]; ///< User seed entropy pool.
+	uint64_t ChunkIndex; ///< Index of the current chunk.
+	size_t ChunkFill; ///< The number of bytes in the current chunk.
+	size_t HashLen; ///< Hash length, in bytes.
+	int ThreadCount; ///< The number of threads to use, >= 1.
+} PRVHASH64S_TREE_CTX;
+
+/**
+ * An auxiliary function that initializes a leaf or the root hashing session.
+ * The seed entropy pool is derived from the user seeds, session's mark, and
+ * chunk's index.
+ *
+ * @param[out] ctx Session's context structure.
+ * @param HashLen Hash length, in bytes.
+ * @param Seeds User seed entropy pool, PRH64ST_SEEDS bytes.
+ * @param Mark Session's seed mark.
+ * @param Index Chunk's index, 0 for the root session.
+ */
+
+static inline void prvhash64s_tree_sinit( PRVHASH64S_CTX* const ctx,
+	const size_t HashLen, const uint8_t* const Seeds, const uint64_t Mark,
+	const uint64_t Index )
+{
+	uint8_t s[ PRH64ST_SEEDS ];
+	PRH64S_T v[ PRH64S_FUSE ];
+	int i;
+
+	for( i = 0; i < PRH64S_FUSE; i++ )
+	{
+		v[ i ] = PRH64S_LUEC( Seeds + i * PRH64S_S );
+	}
+
+	v[ 0 ] ^= Index;
+	v[ 1 ] ^= Mark;
+
+	for( i = 0; i < PRH64S_FUSE; i++ )
+	{
+		v[ i ] = PRH64S_EC( v[ i ]);
+		memcpy( s + i * PRH64S_S, &v[ i ], PRH64S_S );
+	}
+
+	prvhash64s_init( ctx, HashLen, s );
+}
+
+/**
+ * Leaf hashing job, used by the prvhash64s_tree_leaves() function.
+ */
+
+typedef struct {
+	const uint8_t* Msg; ///< Message's start, at chunk boundary.
+	size_t MsgLen; ///< Message's length, in bytes.
+	uint64_t FirstIndex; ///< Index of the first chunk.
+	size_t First; ///< First chunk to hash (relative).
+	size_t Count; ///< The number of chunks in the message.
+	size_t Step; ///< Chunk index increment.
+	const uint8_t* Seeds; ///< User seed entropy pool.
+	size_t HashLen; ///< Hash length, in bytes.
+	uint8_t* LeafOut; ///< Leaf digests, Count * HashLen bytes.
+} PRVHASH64S_TREE_JOB;
+
+/**
+ * Thread function that hashes chunks of a PRVHASH64S_TREE_JOB job.
+ *
+ * @param arg Pointer to the job structure.
+ */
+
+static PRVHASH_THREAD_RET prvhash64s_tree_job( void* const arg )
+{
+	const PRVHASH64S_TREE_JOB* const job = (const PRVHASH64S_TREE_JOB*) arg;
+	PRVHASH64S_CTX ctx;
+	size_t k;
+
+	for( k = job -> First; k < job -> Count; k += job -> Step )
+	{
+		const size_t o = k * PRH64ST_CHUNK;
+		const size_t l = job -> MsgLen - o;
+
+		prvhash64s_tree_sinit( &ctx, job -> HashLen, job -> Seeds,
+			PRH64ST_LEAF, job -> FirstIndex + k );
+
+		prvhash64s_update( &ctx, job -> Msg + o,
+			( l > PRH64ST_CHUNK ? PRH64ST_CHUNK : l ));
+
+		prvhash64s_final( &ctx, job -> LeafOut + k * job -> HashLen );
+	}
+
+	PRVHASH_THREAD_EXIT;
+}
+
+/**
+ * An auxiliary function that hashes the specified chunks, and absorbs their
+ * digests into the root hashing session. Uses up to ThreadCount threads, and
+ * falls back to the calling thread if threads or memory are unavailable.
+ *
+ * @param[in,out] ctx Tree context structure, ChunkIndex is advanced.
+ * @param Msg Message's start, at chunk boundary.
+ * @param Count The number of chunks to hash; all chunks except the last one
+ * should be PRH64ST_CHUNK bytes long.
+ * @param MsgLen Message's length, in bytes, should not exceed
+ * Count * PRH64ST_CHUNK.
+ */
+
+static inline void prvhash64s_tree_leaves( PRVHASH64S_TREE_CTX* const ctx,
+	const uint8_t* const Msg, const size_t Count, const size_t MsgLen )
+{
+	uint8_t* const LeafOut = (uint8_t*) malloc( Count * ctx -> HashLen );
+	int tc = ctx -> ThreadCount;
+
+	if( (size_t) tc > Count )
+	{
+		tc = (int) Count;
+	}
+
+	if( LeafOut == 0 || tc < 2 )
+	{
+		uint8_t h[ PRH64S_MAX ];
+		size_t k;
+
+		for( k = 0; k < Count; k++ )
+		{
+			const size_t l = MsgLen - k * PRH64ST_CHUNK;
+
+			prvhash64s_tree_sinit( &ctx -> Leaf, ctx -> HashLen,
+				ctx -> Seeds, PRH64ST_LEAF, ctx -> ChunkIndex );
+
+			prvhash64s_update( &ctx -> Leaf, Msg + k * PRH64ST_CHUNK,
+				( l > PRH64ST_CHUNK ? PRH64ST_CHUNK : l ));
+
+			prvhash64s_final( &ctx -> Leaf, h );
+			prvhash64s_update( &ctx -> Root, h, ctx -> HashLen );
+			ctx -> ChunkIndex++;
+		}
+
+		free( LeafOut );
+		return;
+	}
+
+	PRVHASH64S_TREE_JOB jobs[ PRVHASH_THREAD_MAX ];
+	int i;
+
+	for( i = 0; i < tc; i++ )
+	{
+		jobs[ i ].Msg = Msg;
+		jobs[ i ].MsgLen = MsgLen;
+		jobs[ i ].FirstIndex = ctx -> ChunkIndex;
+		jobs[ i ].First = (size_t) i;
+		jobs[ i ].Count = Count;
+		jobs[ i ].Step = (size_t) tc;
+		jobs[ i ].Seeds = ctx -> Seeds;
+		jobs[ i ].HashLen = ctx -> HashLen;
+		jobs[ i ].LeafOut = LeafOut;
+	}
+
+	prvhash_thread_run( prvhash64s_tree_job, jobs, sizeof( jobs[ 0 ]), tc );
+
+	prvhash64s_update( &ctx -> Root, LeafOut, Count * ctx -> HashLen );
+	ctx -> ChunkIndex += Count;
+
+	free( LeafOut );
+}
+
+/**
+ * PRVHASH64S_TREE streaming hash function initialization. This function
+ * should be called before the hashing session.
+ *
+ * @param[out] ctx Context structure. Should be aligned to PRH64S_S bytes.
+ * @param HashLen The required hash length, in bytes; should be >= PRH64S_S,
+ * in increments of PRH64S_S. Should not exceed PRH64S_MAX.
+ * @param UseSeeds Optional pointer to seed entropy pool, to use instead of
+ * the default seeds. To use the default seeds, set to 0. If specified, the
+ * UseSeeds should point to a PRH64ST_SEEDS-byte array, see the
+ * prvhash64s_init() function for details.
+ * @param ThreadCount The number of threads to use for hashing of long
+ * update() inputs. If <= 0, the number of processor cores is used.
+ */
+
+static inline void prvhash64s_tree_init( PRVHASH64S_TREE_CTX* const ctx,
+	const size_t HashLen, const void* const UseSeeds, const int ThreadCount )
+{
+	if( UseSeeds == 0 )
+	{
+		memset( ctx -> Seeds, 0, PRH64ST_SEEDS );
+	}
+	else
+	{
+		memcpy( ctx -> Seeds, UseSeeds, PRH64ST_SEEDS );
+	}
+
+	ctx -> ChunkIndex = 0;
+	ctx -> ChunkFill = 0;
+	ctx -> HashLen = HashLen;
+	ctx -> ThreadCount = ( ThreadCount > 0 ?
+		( ThreadCount > PRVHASH_THREAD_MAX ? PRVHASH_THREAD_MAX :
+		ThreadCount ) : prvhash_thread_count() );
+
+	prvhash64s_tree_sinit( &ctx -> Root, HashLen, ctx -> Seeds,
+		PRH64ST_ROOT, 0 );
+
+	prvhash64s_tree_sinit( &ctx -> Leaf, HashLen, ctx -> Seeds,
+		PRH64ST_LEAF, 0 );
+}
+
+/**
+ * This function updates the hash according to the contents of the message.
+ * Long inputs that span several chunks are hashed by multiple threads.
+ * Before this function can be called, the prvhash64s_tree_init() should be
+ * called. When the streamed hashing is finished, the prvhash64s_tree_final()
+ * function should be called. The resulting hash does not depend on how the
+ * message is split between the update() calls.
+ *
+ * @param[in,out] ctx Context structure.
+ * @param Msg0 The message to produce a hash from. The address alignment of
+ * this pointer is unimportant. Can be 0 if MsgLen==0.
+ * @param MsgLen Message's length, in bytes; can be 0.
+ */
+
+static inline void prvhash64s_tree_update( PRVHASH64S_TREE_CTX* const ctx,
+	const void* const Msg0, size_t MsgLen )
+{
+	const uint8_t* Msg = (const uint8_t*) Msg0;
+
+	while( MsgLen != 0 )
+	{
+		if( ctx -> ChunkFill == PRH64ST_CHUNK )
+		{
+			// The current chunk is complete, and the message continues.
+
+			uint8_t h[ PRH64S_MAX ];
+
+			prvhash64s_final( &ctx -> Leaf, h );
+			prvhash64s_update( &ctx -> Root, h, ctx -> HashLen );
+			ctx -> ChunkIndex++;
+			ctx -> ChunkFill = 0;
+
+			// Whole chunks followed by more data are hashed in parallel,
+			// the last chunk remains open.
+
+			const size_t c = ( MsgLen - 1 ) / PRH64ST_CHUNK;
+
+			if( c != 0 )
+			{
+				prvhash64s_tree_leaves( ctx, Msg, c, c * PRH64ST_CHUNK );
+
+				Msg += c * PRH64ST_CHUNK;
+				MsgLen -= c * PRH64ST_CHUNK;
+			}
+
+			prvhash64s_tree_sinit( &ctx -> Leaf, ctx -> HashLen,
+				ctx -> Seeds, PRH64ST_LEAF, ctx -> ChunkIndex );
+		}
+
+		size_t l = PRH64ST_CHUNK - ctx -> ChunkFill;
+		l = ( l > MsgLen ? MsgLen : l );
+
+		prvhash64s_update( &ctx -> Leaf, Msg, l );
+		ctx -> ChunkFill += l;
+
+		Msg += l;
+		MsgLen -= l;
+	}
+}
+
+/**
+ * This function finalizes the streamed hashing. This function applies
+ * endianness-correction to the resulting hash value automatically.
+ *
+ * @param[in,out] ctx Context structure. Zeroed on function's return.
+ * @param[out] HashOut The hash buffer to receive the resulting hash value.
+ * Buffer's size should match the HashLen specified during initialization.
+ * The address alignment of this buffer is unimportant.
+ */
+
+static inline void prvhash64s_tree_final( PRVHASH64S_TREE_CTX* const ctx,
+	void* const HashOut )
+{
+	uint8_t h[ PRH64S_MAX ];
+
+	prvhash64s_final( &ctx -> Leaf, h );
+	prvhash64s_update( &ctx -> Root, h, ctx -> HashLen );
+	prvhash64s_final( &ctx -> Root, HashOut );
+
+	memset( ctx, 0, sizeof( PRVHASH64S_TREE_CTX ));
+}
+
+/**
+ * This function calculates the "prvhash64s_tree" hash of the specified
+ * message in the "oneshot" mode, with default seed settings, using the
+ * specified number of threads.
+ *
+ * @param Msg The message to produce a hash from. The alignment of this
+ * pointer is unimportant.
+ * @param MsgLen Message's length, in bytes.
+ * @param[out] Hash The hash buffer, length = HashLen. The address alignment
+ * of this buffer is unimportant.
+ * @param HashLen The required hash length, in bytes; should be >= PRH64S_S,
+ * in increments of PRH64S_S. Should not exceed PRH64S_MAX.
+ * @param ThreadCount The number of threads to use. If <= 0, the number of
+ * processor cores is used.
+ * @return 0 if memory allocation failed.
+ */
+
+static inline int prvhash64s_tree_oneshot( const void* const Msg,
+	const size_t MsgLen, void* const Hash, const size_t HashLen,
+	const int ThreadCount )
+{
+	PRVHASH64S_TREE_CTX* const ctx =
+		(PRVHASH64S_TREE_CTX*) malloc( sizeof( PRVHASH64S_TREE_CTX ));
+
+	if( ctx == 0 )
+	{
+		return( 0 );
+	}
+
+	prvhash64s_tree_init( ctx, HashLen, 0, ThreadCount );
+
+	// The last chunk is hashed by the final() call.
+
+	const size_t c = ( MsgLen == 0 ? 0 : ( MsgLen - 1 ) / PRH64ST_CHUNK );
+
+	if( c != 0 )
+	{
+		prvhash64s_tree_leaves( ctx, (const uint8_t*) Msg, c,
+			c * PRH64ST_CHUNK );
+
+		prvhash64s_tree_sinit( &ctx -> Leaf, HashLen, ctx -> Seeds,
+			PRH64ST_LEAF, ctx -> ChunkIndex );
+	}
+
+	prvhash64s_update( &ctx -> Leaf, (const uint8_t*) Msg +
+		c * PRH64ST_CHUNK, MsgLen - c * PRH64ST_CHUNK );
+
+	prvhash64s_tree_final( ctx, Hash );
+	free( ctx );
+
+	return( 1 );
+}
+
+#endif // PRVHASH64S_TREE_INCLUDED
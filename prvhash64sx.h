@@ -0,0 +1,89 @@
+/**
+ * prvhash64sx.h version 4.3.0
+ *
+ * The inclusion file for the "prvhash64s8" and "prvhash64s16" hash
+ * functions: 8- and 16-way fused variants of the "prvhash64s" streamed hash
+ * function, for a higher throughput on processors with wide out-of-order
+ * execution. These are separate hash functions: they produce hash values
+ * that are different to the "prvhash64s" hash function, and to each other.
+ *
+ * Description is available at https://github.com/avaneev/prvhash
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PRVHASH64SX_INCLUDED
+#define PRVHASH64SX_INCLUDED
+
+#include "prvhash64s.h"
+
+// Macro that requests full unrolling of the following constant-count loop.
+
+#if defined( __clang__ )
+
+	#define PRVHASH_UNROLL _Pragma( "unroll" )
+
+#elif defined( __GNUC__ ) && __GNUC__ >= 8
+
+	#define PRVHASH_UNROLL _Pragma( "GCC unroll 16" )
+
+#else // defined( __GNUC__ )
+
+	#define PRVHASH_UNROLL
+
+#endif // defined( __GNUC__ )
+
+#define PRH64S8_FUSE 8 // PRVHASH fusing of "prvhash64s8".
+#define PRH64S8_LEN ( PRH64S_S * PRH64S8_FUSE ) // Intermediate block's length.
+#define PRH64S16_FUSE 16 // PRVHASH fusing of "prvhash64s16".
+#define PRH64S16_LEN ( PRH64S_S * PRH64S16_FUSE ) // Intermediate block's len.
+
+// "prvhash64s8_X" functions and the PRVHASH64S8_CTX structure.
+
+#define PRH64SX_FUSE PRH64S8_FUSE
+#define PRH64SX_LEN PRH64S8_LEN
+#define PRH64SX_CTX PRVHASH64S8_CTX
+#define PRH64SX_FN( n ) prvhash64s8_##n
+
+#include "prvhash64sx_tpl.h"
+
+#undef PRH64SX_FUSE
+#undef PRH64SX_LEN
+#undef PRH64SX_CTX
+#undef PRH64SX_FN
+
+// "prvhash64s16_X" functions and the PRVHASH64S16_CTX structure.
+
+#define PRH64SX_FUSE PRH64S16_FUSE
+#define PRH64SX_LEN PRH64S16_LEN
+#define PRH64SX_CTX PRVHASH64S16_CTX
+#define PRH64SX_FN( n ) prvhash64s16_##n
+
+#include "prvhash64sx_tpl.h"
+
+#undef PRH64SX_FUSE
+#undef PRH64SX_LEN
+#undef PRH64SX_CTX
+#undef PRH64SX_FN
+
+#endif // PRVHASH64SX_INCLUDED
@@ -0,0 +1,386 @@
+/**
+ * prvhash64sx_tpl.h version 4.3.0
+ *
+ * The template file for the "prvhash64sN" wide-fused streamed hash functions.
+ * This file should not be included directly; please include the
+ * "prvhash64sx.h" file instead. Before inclusion, the following macros
+ * should be defined: PRH64SX_FUSE (the number of fused "Seed" and "lcg"
+ * lanes, in multiples of 4), PRH64SX_LEN (intermediate block's length),
+ * PRH64SX_CTX (context structure's type name), PRH64SX_FN( n ) (function
+ * name generator).
+ *
+ * Lanes are arranged in groups of 4, with each group being arranged like
+ * the "prvhash64s" hash function. Groups update adjacent hashwords, to avoid
+ * a serial dependency between all lanes via a single hashword.
+ *
+ * Description is available at https://github.com/avaneev/prvhash
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#define PRH64SX_GROUPS ( PRH64SX_FUSE / 4 ) // The number of lane groups.
+
+/**
+ * The context structure of the "prvhash64sN_X" functions. On systems where
+ * this is relevant, this structure should be aligned to PRH64S_S bytes.
+ */
+
+typedef struct {
+	PRH64S_T Seed[ PRH64SX_FUSE ]; ///< Current fused "Seed" values.
+	PRH64S_T lcg[ PRH64SX_FUSE ]; ///< Current fused "lcg" values.
+	uint8_t Hash[ PRH64S_MAX ]; ///< Working hash buffer.
+	uint8_t Block[ PRH64SX_LEN ]; ///< Intermediate input data block.
+	uint64_t MsgLen; ///< Message length counter, in bytes.
+	size_t HashLen; ///< Hash buffer length, in bytes, >= PRH64S_S,
+		///< increments of PRH64S_S.
+	size_t HashPos; ///< Hash buffer position.
+	size_t BlockFill; ///< The number of bytes filled in the Block.
+	uint8_t fb; ///< Final stream byte value, for hashing finalization.
+} PRH64SX_CTX;
+
+/**
+ * An auxiliary function that returns hashword pointers of lane groups, for
+ * the current hash buffer position.
+ *
+ * @param ctx Context structure.
+ * @param[out] hc Hashword pointers, PRH64SX_GROUPS elements.
+ */
+
+static PRVHASH_INLINE void PRH64SX_FN( hcs )( PRH64SX_CTX* const ctx,
+	PRH64S_T** const hc )
+{
+	const PRH64S_T* const HashEnd =
+		(PRH64S_T*) ( ctx -> Hash + ctx -> HashLen );
+
+	int g;
+
+	hc[ 0 ] = (PRH64S_T*) ( ctx -> Hash + ctx -> HashPos );
+
+	for( g = 1; g < PRH64SX_GROUPS; g++ )
+	{
+		hc[ g ] = hc[ g - 1 ] + 1;
+
+		if( hc[ g ] == HashEnd )
+		{
+			hc[ g ] = (PRH64S_T*) ctx -> Hash;
+		}
+	}
+}
+
+/**
+ * An auxiliary function that performs a single round of all lanes, and
+ * optionally advances hashword pointers. Using local "Seed" and "lcg"
+ * arrays allows the compiler to keep them in registers.
+ *
+ * @param[in,out] Seed "Seed" values, PRH64SX_FUSE elements.
+ * @param[in,out] lcg "lcg" values, PRH64SX_FUSE elements.
+ * @param[in,out] hc Hashword pointers, PRH64SX_GROUPS elements.
+ * @param Hash Hash buffer's start.
+ * @param HashEnd Hash buffer's end.
+ * @param adv If non-zero, advance hashword pointers.
+ * @return XOR of the outputs of the last lane of each group.
+ */
+
+static PRVHASH_INLINE PRH64S_T PRH64SX_FN( round )( PRH64S_T* const Seed,
+	PRH64S_T* const lcg, PRH64S_T** const hc, uint8_t* const Hash,
+	const PRH64S_T* const HashEnd, const int adv )
+{
+	PRH64S_T res = 0;
+	int i;
+
+	PRVHASH_UNROLL
+	for( i = 0; i < PRH64SX_FUSE; i++ )
+	{
+		const PRH64S_T out = PRH64S_FN( Seed + i, lcg + i, hc[ i >> 2 ]);
+
+		if(( i & 3 ) == 3 )
+		{
+			res ^= out;
+		}
+	}
+
+	if( adv )
+	{
+		PRVHASH_UNROLL
+		for( i = 0; i < PRH64SX_GROUPS; i++ )
+		{
+			if( ++hc[ i ] == HashEnd )
+			{
+				hc[ i ] = (PRH64S_T*) Hash;
+			}
+		}
+	}
+
+	return( res );
+}
+
+/**
+ * An auxiliary function that absorbs a single PRH64SX_LEN-byte block.
+ *
+ * @param[in,out] Seed "Seed" values, PRH64SX_FUSE elements.
+ * @param[in,out] lcg "lcg" values, PRH64SX_FUSE elements.
+ * @param[in,out] hc Hashword pointers, PRH64SX_GROUPS elements.
+ * @param Hash Hash buffer's start.
+ * @param HashEnd Hash buffer's end.
+ * @param Msg Block's data, alignment is unimportant.
+ */
+
+static PRVHASH_INLINE void PRH64SX_FN( block )( PRH64S_T* const Seed,
+	PRH64S_T* const lcg, PRH64S_T** const hc, uint8_t* const Hash,
+	const PRH64S_T* const HashEnd, const uint8_t* const Msg )
+{
+	int i;
+
+	PRVHASH_UNROLL
+	for( i = 0; i < PRH64SX_FUSE; i++ )
+	{
+		const PRH64S_T m = PRH64S_LUEC( Msg + i * PRH64S_S );
+
+		Seed[ i ] ^= m;
+		lcg[ i ] ^= m;
+	}
+
+	PRH64SX_FN( round )( Seed, lcg, hc, Hash, HashEnd, 1 );
+}
+
+/**
+ * Streamed hash function initialization, see the prvhash64s_init() function
+ * for details.
+ *
+ * @param[out] ctx Context structure.
+ * @param HashLen The required hash length, in bytes; should be >= PRH64S_S,
+ * in increments of PRH64S_S. Should not exceed PRH64S_MAX.
+ * @param UseSeeds Optional pointer to seed entropy pool, to use instead of
+ * the default seeds. To use the default seeds, set to 0. If specified, the
+ * UseSeeds should point to a PRH64SX_LEN-byte array (PRH64SX_FUSE 64-bit
+ * values), which can have any statistical quality, and can be partially set
+ * to zero. The address alignment of this pointer is unimportant.
+ */
+
+static inline void PRH64SX_FN( init )( PRH64SX_CTX* const ctx,
+	const size_t HashLen, const void* const UseSeeds )
+{
+	memset( ctx -> Hash, 0, HashLen );
+
+	ctx -> MsgLen = 0;
+	ctx -> HashLen = HashLen;
+	ctx -> HashPos = 0;
+	ctx -> BlockFill = 0;
+	ctx -> fb = 0;
+
+	PRH64S_T Seed[ PRH64SX_FUSE ];
+	PRH64S_T lcg[ PRH64SX_FUSE ];
+	PRH64S_T* hc[ PRH64SX_GROUPS ];
+	int i;
+
+	for( i = 0; i < PRH64SX_FUSE; i++ )
+	{
+		Seed[ i ] = ( UseSeeds == 0 ? 0 :
+			PRH64S_LUEC( (const uint8_t*) UseSeeds + i * PRH64S_S ));
+
+		lcg[ i ] = 0;
+	}
+
+	PRH64SX_FN( hcs )( ctx, hc );
+
+	for( i = 0; i < PRVHASH_INIT_COUNT; i++ )
+	{
+		PRH64SX_FN( round )( Seed, lcg, hc, ctx -> Hash, 0, 0 );
+	}
+
+	memcpy( ctx -> Seed, Seed, sizeof( Seed ));
+	memcpy( ctx -> lcg, lcg, sizeof( lcg ));
+}
+
+/**
+ * This function updates the hash according to the contents of the message,
+ * see the prvhash64s_update() function for details.
+ *
+ * @param[in,out] ctx Context structure.
+ * @param Msg0 The message to produce a hash from. The address alignment of
+ * this pointer is unimportant. Can be 0 if MsgLen==0.
+ * @param MsgLen Message's length, in bytes; can be 0.
+ */
+
+static inline void PRH64SX_FN( update )( PRH64SX_CTX* const ctx,
+	const void* const Msg0, size_t MsgLen )
+{
+	if( MsgLen == 0 )
+	{
+		return;
+	}
+
+	ctx -> MsgLen += (uint64_t) MsgLen;
+
+	const uint8_t* Msg = (const uint8_t*) Msg0;
+	size_t blf = ctx -> BlockFill;
+
+	if( blf + MsgLen >= PRH64SX_LEN )
+	{
+		const PRH64S_T* const HashEnd =
+			(PRH64S_T*) ( ctx -> Hash + ctx -> HashLen );
+
+		PRH64S_T Seed[ PRH64SX_FUSE ];
+		PRH64S_T lcg[ PRH64SX_FUSE ];
+		PRH64S_T* hc[ PRH64SX_GROUPS ];
+
+		memcpy( Seed, ctx -> Seed, sizeof( Seed ));
+		memcpy( lcg, ctx -> lcg, sizeof( lcg ));
+		PRH64SX_FN( hcs )( ctx, hc );
+
+		if( blf != 0 )
+		{
+			const size_t CopyLen = PRH64SX_LEN - blf;
+			memcpy( ctx -> Block + blf, Msg, CopyLen );
+			blf = 0;
+
+			Msg += CopyLen;
+			MsgLen -= CopyLen;
+
+			PRH64SX_FN( block )( Seed, lcg, hc, ctx -> Hash, HashEnd,
+				ctx -> Block );
+		}
+
+		while( MsgLen >= PRH64SX_LEN )
+		{
+			PRH64SX_FN( block )( Seed, lcg, hc, ctx -> Hash, HashEnd, Msg );
+
+			Msg += PRH64SX_LEN;
+			MsgLen -= PRH64SX_LEN;
+		}
+
+		memcpy( ctx -> Seed, Seed, sizeof( Seed ));
+		memcpy( ctx -> lcg, lcg, sizeof( lcg ));
+		ctx -> HashPos = (uint8_t*) hc[ 0 ] - ctx -> Hash;
+	}
+
+	memcpy( ctx -> Block + blf, Msg, MsgLen );
+	ctx -> BlockFill = blf + MsgLen;
+
+	if( MsgLen != 0 )
+	{
+		ctx -> fb = Msg[ MsgLen - 1 ];
+	}
+	else
+	{
+		ctx -> fb = Msg[ -1 ];
+	}
+}
+
+/**
+ * This function finalizes the streamed hashing, see the prvhash64s_final()
+ * function for details.
+ *
+ * @param[in,out] ctx Context structure. Zeroed on function's return.
+ * @param[out] HashOut The hash buffer to receive the resulting hash value.
+ * Buffer's size should match the HashLen specified during initialization. The
+ * address alignment of this buffer is unimportant.
+ */
+
+static inline void PRH64SX_FN( final )( PRH64SX_CTX* const ctx,
+	void* const HashOut )
+{
+	uint8_t fbytes[ PRH64SX_LEN ];
+	memset( fbytes, 0, PRH64SX_LEN );
+
+	fbytes[ PRH64S_S - 1 ] = (uint8_t) ( 1 << ( ctx -> fb >> 7 ));
+	PRH64SX_FN( update )( ctx, fbytes, PRH64S_S );
+
+	const uint64_t MsgLen = PRH64S_EC( ctx -> MsgLen );
+	PRH64SX_FN( update )( ctx, &MsgLen, 8 );
+	fbytes[ PRH64S_S - 1 ] = (uint8_t) ( 1 << ( ctx -> fb >> 7 ));
+	PRH64SX_FN( update )( ctx, fbytes, PRH64S_S );
+
+	if( ctx -> BlockFill > 0 )
+	{
+		fbytes[ PRH64S_S - 1 ] = 0;
+		PRH64SX_FN( update )( ctx, fbytes, PRH64SX_LEN - ctx -> BlockFill );
+	}
+
+	const PRH64S_T* const HashEnd =
+		(PRH64S_T*) ( ctx -> Hash + ctx -> HashLen );
+
+	PRH64S_T Seed[ PRH64SX_FUSE ];
+	PRH64S_T lcg[ PRH64SX_FUSE ];
+	PRH64S_T* hc[ PRH64SX_GROUPS ];
+
+	memcpy( Seed, ctx -> Seed, sizeof( Seed ));
+	memcpy( lcg, ctx -> lcg, sizeof( lcg ));
+	PRH64SX_FN( hcs )( ctx, hc );
+
+	const size_t fc = PRH64S_S + ( ctx -> HashLen == PRH64S_S ? 0 :
+		ctx -> HashLen + ( ctx -> MsgLen < ctx -> HashLen * PRH64SX_FUSE ?
+		(uint8_t*) HashEnd - (uint8_t*) hc[ 0 ] : 0 ));
+
+	size_t k;
+
+	for( k = 0; k <= fc; k += PRH64S_S )
+	{
+		PRH64SX_FN( round )( Seed, lcg, hc, ctx -> Hash, HashEnd, 1 );
+	}
+
+	uint8_t* const ho = (uint8_t*) HashOut;
+
+	for( k = 0; k < ctx -> HashLen; k += PRH64S_S )
+	{
+		PRH64S_T res = 0;
+		int i;
+
+		for( i = 0; i < 4; i++ )
+		{
+			res ^= PRH64SX_FN( round )( Seed, lcg, hc, ctx -> Hash,
+				HashEnd, 1 );
+		}
+
+		res = PRH64S_EC( res );
+		memcpy( ho + k, &res, PRH64S_S );
+	}
+
+	memset( ctx, 0, sizeof( PRH64SX_CTX ));
+}
+
+/**
+ * This function calculates the hash of the specified message in the
+ * "oneshot" mode, with default seed settings, without using streaming
+ * capabilities.
+ *
+ * @param Msg The message to produce a hash from. The alignment of this
+ * pointer is unimportant.
+ * @param MsgLen Message's length, in bytes.
+ * @param[out] Hash The hash buffer, length = HashLen. The address alignment
+ * of this buffer is unimportant.
+ * @param HashLen The required hash length, in bytes; should be >= PRH64S_S,
+ * in increments of PRH64S_S. Should not exceed PRH64S_MAX.
+ */
+
+static inline void PRH64SX_FN( oneshot )( const void* const Msg,
+	const size_t MsgLen, void* const Hash, const size_t HashLen )
+{
+	PRH64SX_CTX ctx;
+
+	PRH64SX_FN( init )( &ctx, HashLen, 0 );
+	PRH64SX_FN( update )( &ctx, Msg, MsgLen );
+	PRH64SX_FN( final )( &ctx, Hash );
+}
+
+#undef PRH64SX_GROUPS
@@ -0,0 +1,351 @@
+/**
+ * prvhash_cdc.h version 4.3.0
+ *
+ * The inclusion file for the "prvhash_cdc" content-defined chunking
+ * functions, for data deduplication. Chunk boundaries are found via a "gear"
+ * rolling hash, whose table is produced by the PRVHASH core function, with
+ * FastCDC-like normalized chunking that keeps chunk lengths within the
+ * specified minimal and maximal lengths, and close to the average length.
+ * Each chunk also receives a "prvhash64s" digest, calculated in the same
+ * pass over memory.
+ *
+ * Description is available at https://github.com/avaneev/prvhash
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PRVHASH_CDC_INCLUDED
+#define PRVHASH_CDC_INCLUDED
+
+#include "prvhash64s.h"
+
+#define PRVHASH_CDC_WIN 64 // Rolling hash's window length, in bytes.
+#define PRVHASH_CDC_NORM 2 // Normalization level, in mask bits.
+#define PRVHASH_CDC_SLICE 16384 // Portion scanned before being digested.
+
+/**
+ * Chunker's context structure.
+ */
+
+typedef struct
+{
+	uint64_t Gear[ 256 ]; ///< Gear table, a random value per byte value.
+	uint64_t MaskS; ///< Boundary mask used before the average length.
+	uint64_t MaskL; ///< Boundary mask used after the average length.
+	size_t MinSize; ///< Minimal chunk length, in bytes.
+	size_t AvgSize; ///< Average chunk length, in bytes.
+	size_t MaxSize; ///< Maximal chunk length, in bytes.
+	size_t HashLen; ///< Chunk digest's length, in bytes.
+	uint64_t Fp; ///< Current rolling hash value.
+	size_t ChunkLen; ///< Length of the current chunk so far, in bytes.
+	size_t LastLen; ///< Length of the last completed chunk, in bytes.
+	PRVHASH64S_CTX hctx; ///< Digest context of the current chunk.
+} PRVHASH_CDC_CTX;
+
+/**
+ * Internal function returns a mask that has the specified number of the
+ * highest bits set: these bits of the "gear" hash depend on the most recent
+ * PRVHASH_CDC_WIN bytes.
+ *
+ * @param b The number of bits, 1 to 63.
+ */
+
+static inline uint64_t prvhash_cdc_mask( const int b )
+{
+	return( ~( ~(uint64_t) 0 >> b ));
+}
+
+/**
+ * Function initializes the chunker's context.
+ *
+ * @param[out] ctx Context structure.
+ * @param MinSize Minimal chunk length, in bytes, >= PRVHASH_CDC_WIN.
+ * @param AvgSize Average chunk length, in bytes, a power of 2 >= 256,
+ * > MinSize.
+ * @param MaxSize Maximal chunk length, in bytes, > AvgSize.
+ * @param HashLen Chunk digest's length, in bytes, as required by the
+ * prvhash64s_init() function.
+ * @param GearSeed Seed of the "gear" table; different seeds produce
+ * different, unpredictable, chunk boundaries. Use 0 by default.
+ * @return 0 if the lengths are invalid.
+ */
+
+static inline int prvhash_cdc_init( PRVHASH_CDC_CTX* const ctx,
+	const size_t MinSize, const size_t AvgSize, const size_t MaxSize,
+	const size_t HashLen, const uint64_t GearSeed )
+{
+	if( MinSize < PRVHASH_CDC_WIN || AvgSize <= MinSize ||
+		MaxSize <= AvgSize || AvgSize < 256 ||
+		( AvgSize & ( AvgSize - 1 )) != 0 )
+	{
+		return( 0 );
+	}
+
+	uint64_t Seed = GearSeed;
+	uint64_t lcg = 0;
+	uint64_t Hash = 0;
+	int i;
+
+	for( i = 0; i < PRVHASH_INIT_COUNT; i++ )
+	{
+		prvhash_core64( &Seed, &lcg, &Hash );
+	}
+
+	for( i = 0; i < 256; i++ )
+	{
+		ctx -> Gear[ i ] = prvhash_core64( &Seed, &lcg, &Hash );
+	}
+
+	int b = 0;
+
+	while( ( (size_t) 1 << b ) < AvgSize )
+	{
+		b++;
+	}
+
+	ctx -> MaskS = prvhash_cdc_mask( b + PRVHASH_CDC_NORM );
+	ctx -> MaskL = prvhash_cdc_mask( b - PRVHASH_CDC_NORM );
+	ctx -> MinSize = MinSize;
+	ctx -> AvgSize = AvgSize;
+	ctx -> MaxSize = MaxSize;
+	ctx -> HashLen = HashLen;
+	ctx -> Fp = 0;
+	ctx -> ChunkLen = 0;
+	ctx -> LastLen = 0;
+
+	prvhash64s_init( &ctx -> hctx, HashLen, 0 );
+
+	return( 1 );
+}
+
+/**
+ * Internal function scans the data for a chunk boundary, continuing the
+ * current chunk. The first MinSize bytes of a chunk are skipped. Before
+ * the average length, a stricter boundary mask is used, after it - a looser
+ * one, and a chunk is always cut at the maximal length.
+ *
+ * @param ctx Context structure.
+ * @param Msg Data to scan.
+ * @param MsgLen Data length, in bytes, > 0.
+ * @param[in,out] ChunkLen Current chunk's length. Receives the completed
+ * chunk's length, if a boundary was found.
+ * @param[in,out] Fp Current rolling hash value.
+ * @return The number of bytes until and including the boundary, or 0 if no
+ * boundary was found, and all bytes were added to the chunk.
+ */
+
+static inline size_t prvhash_cdc_scan( const PRVHASH_CDC_CTX* const ctx,
+	const uint8_t* const Msg, const size_t MsgLen, size_t* const ChunkLen,
+	uint64_t* const Fp )
+{
+	const uint64_t* const Gear = ctx -> Gear;
+	const size_t cl = *ChunkLen;
+	uint64_t fp = *Fp;
+	size_t i = 0;
+	size_t e;
+
+	if( cl < ctx -> MinSize )
+	{
+		i = ctx -> MinSize - cl;
+
+		if( i >= MsgLen )
+		{
+			*ChunkLen = cl + MsgLen;
+			return( 0 );
+		}
+	}
+
+	if( cl + i < ctx -> AvgSize )
+	{
+		const uint64_t m = ctx -> MaskS;
+		e = ctx -> AvgSize - cl;
+		e = ( e < MsgLen ? e : MsgLen );
+
+		while( i < e )
+		{
+			fp = ( fp << 1 ) + Gear[ Msg[ i ]];
+			i++;
+
+			if(( fp & m ) == 0 )
+			{
+				goto cut;
+			}
+		}
+	}
+
+	e = ctx -> MaxSize - cl;
+	e = ( e < MsgLen ? e : MsgLen );
+
+	if( i < e )
+	{
+		const uint64_t m = ctx -> MaskL;
+
+		while( i < e )
+		{
+			fp = ( fp << 1 ) + Gear[ Msg[ i ]];
+			i++;
+
+			if(( fp & m ) == 0 )
+			{
+				goto cut;
+			}
+		}
+	}
+
+	if( cl + i < ctx -> MaxSize )
+	{
+		*ChunkLen = cl + MsgLen;
+		*Fp = fp;
+
+		return( 0 );
+	}
+
+cut:
+	*ChunkLen = cl + i;
+	*Fp = 0;
+
+	return( i );
+}
+
+/**
+ * Function finds the first chunk boundary in the data which starts at a
+ * chunk's beginning. Does not calculate digests, and does not change the
+ * context, so it can be called concurrently.
+ *
+ * @param ctx Initialized context structure.
+ * @param Msg Data to scan. The address alignment is unimportant.
+ * @param MsgLen Data length, in bytes.
+ * @return The length of the first chunk; equals MsgLen if no boundary was
+ * found.
+ */
+
+static inline size_t prvhash_cdc_find( const PRVHASH_CDC_CTX* const ctx,
+	const void* const Msg, const size_t MsgLen )
+{
+	if( MsgLen == 0 )
+	{
+		return( 0 );
+	}
+
+	size_t cl = 0;
+	uint64_t fp = 0;
+	const size_t l = prvhash_cdc_scan( ctx, (const uint8_t*) Msg, MsgLen,
+		&cl, &fp );
+
+	return( l == 0 ? MsgLen : l );
+}
+
+/**
+ * Internal function finishes the current chunk: produces its digest, and
+ * starts the next chunk.
+ *
+ * @param ctx Context structure.
+ * @param[out] Hash Chunk's digest.
+ */
+
+static inline void prvhash_cdc_cut( PRVHASH_CDC_CTX* const ctx,
+	void* const Hash )
+{
+	prvhash64s_final( &ctx -> hctx, Hash );
+	prvhash64s_init( &ctx -> hctx, ctx -> HashLen, 0 );
+
+	ctx -> LastLen = ctx -> ChunkLen;
+	ctx -> ChunkLen = 0;
+	ctx -> Fp = 0;
+}
+
+/**
+ * Function continues the current chunk with the data, until the chunk's
+ * boundary is found. The data is scanned and digested in
+ * PRVHASH_CDC_SLICE-byte portions, so that every portion is read from memory
+ * only once. Chunks may span any number of calls. Usage example:
+ *
+ * while(( l = prvhash_cdc_update( &ctx, p, n, h )) != 0 )
+ * {
+ *     // Use ctx.LastLen and h.
+ *     p += l;
+ *     n -= l;
+ * }
+ *
+ * @param ctx Initialized context structure.
+ * @param Msg Data. The address alignment is unimportant.
+ * @param MsgLen Data length, in bytes.
+ * @param[out] Hash Receives the completed chunk's digest, HashLen bytes, if
+ * a boundary was found. The chunk's length is then available in the
+ * ctx -> LastLen.
+ * @return The number of bytes consumed, until and including the boundary,
+ * or 0, if no boundary was found and all bytes were consumed.
+ */
+
+static inline size_t prvhash_cdc_update( PRVHASH_CDC_CTX* const ctx,
+	const void* const Msg, const size_t MsgLen, void* const Hash )
+{
+	const uint8_t* const p = (const uint8_t*) Msg;
+	size_t o = 0;
+
+	while( o < MsgLen )
+	{
+		const size_t l = ( MsgLen - o > PRVHASH_CDC_SLICE ?
+			PRVHASH_CDC_SLICE : MsgLen - o );
+
+		const size_t c = prvhash_cdc_scan( ctx, p + o, l, &ctx -> ChunkLen,
+			&ctx -> Fp );
+
+		if( c != 0 )
+		{
+			prvhash64s_update( &ctx -> hctx, p + o, c );
+			prvhash_cdc_cut( ctx, Hash );
+
+			return( o + c );
+		}
+
+		prvhash64s_update( &ctx -> hctx, p + o, l );
+		o += l;
+	}
+
+	return( 0 );
+}
+
+/**
+ * Function finishes the last chunk, at the end of data.
+ *
+ * @param ctx Initialized context structure.
+ * @param[out] Hash Receives the last chunk's digest, HashLen bytes, if the
+ * chunk is not empty.
+ * @return The last chunk's length, 0 if it is empty.
+ */
+
+static inline size_t prvhash_cdc_final( PRVHASH_CDC_CTX* const ctx,
+	void* const Hash )
+{
+	if( ctx -> ChunkLen == 0 )
+	{
+		return( 0 );
+	}
+
+	prvhash_cdc_cut( ctx, Hash );
+
+	return( ctx -> LastLen );
+}
+
+#endif // PRVHASH_CDC_INCLUDED
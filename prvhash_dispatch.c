@@ -0,0 +1,167 @@
+/**
+ * prvhash_dispatch.c version 4.3.2
+ *
+ * The main source file of the PRVHASH runtime dispatch module (see
+ * prvhash_dispatch.h): compiles the "default" function table, using the
+ * instruction set the file is compiled for, and selects the function table
+ * best suited for the processor.
+ *
+ * Description is available at https://github.com/avaneev/prvhash
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#define PRVHASH_DISPATCH_FN( n ) prvhash_dispatch_default_##n
+#define PRVHASH_DISPATCH_NAME "default"
+
+#include "prvhash_dispatch_tpl.h"
+
+#if defined( PRVHASH_DISPATCH_X86 )
+
+	#if defined( _MSC_VER )
+		#include <intrin.h>
+	#endif // defined( _MSC_VER )
+
+	extern const PRVHASH_DISPATCH prvhash_dispatch_avx2_table;
+	extern const PRVHASH_DISPATCH prvhash_dispatch_avx512_table;
+
+#endif // defined( PRVHASH_DISPATCH_X86 )
+
+#define PRVHASH_DISPATCH_AVX2 1 // Processor feature flag, AVX2.
+#define PRVHASH_DISPATCH_AVX512 2 // Processor feature flag, AVX-512 F+DQ+VL.
+
+/**
+ * Internal function returns the processor feature flags.
+ */
+
+static int prvhash_dispatch_features( void )
+{
+	int f = 0;
+
+#if defined( PRVHASH_DISPATCH_X86 )
+
+	#if defined( _MSC_VER )
+
+		int r[ 4 ];
+		__cpuid( r, 0 );
+
+		if( r[ 0 ] >= 7 )
+		{
+			__cpuid( r, 1 );
+
+			// OSXSAVE, and the OS saves YMM and ZMM registers.
+
+			const int osx = (( r[ 2 ] >> 27 ) & 1 ) != 0;
+			const unsigned long long xcr = ( osx ? _xgetbv( 0 ) : 0 );
+
+			__cpuidex( r, 7, 0 );
+
+			if(( xcr & 6 ) == 6 && ( r[ 1 ] & ( 1 << 5 )) != 0 )
+			{
+				f |= PRVHASH_DISPATCH_AVX2;
+			}
+
+			if(( xcr & 0xE6 ) == 0xE6 && ( r[ 1 ] & ( 1 << 16 )) != 0 &&
+				( r[ 1 ] & ( 1 << 17 )) != 0 && ( r[ 1 ] & ( 1 << 31 )) != 0 )
+			{
+				f |= PRVHASH_DISPATCH_AVX512;
+			}
+		}
+
+	#else // defined( _MSC_VER )
+
+		__builtin_cpu_init();
+
+		if( __builtin_cpu_supports( "avx2" ))
+		{
+			f |= PRVHASH_DISPATCH_AVX2;
+		}
+
+		if( __builtin_cpu_supports( "avx512f" ) &&
+			__builtin_cpu_supports( "avx512dq" ) &&
+			__builtin_cpu_supports( "avx512vl" ))
+		{
+			f |= PRVHASH_DISPATCH_AVX512;
+		}
+
+	#endif // defined( _MSC_VER )
+
+#endif // defined( PRVHASH_DISPATCH_X86 )
+
+	return( f );
+}
+
+const PRVHASH_DISPATCH* prvhash_dispatch_find( const char* const Name )
+{
+	if( strcmp( Name, "default" ) == 0 )
+	{
+		return( &prvhash_dispatch_default_table );
+	}
+
+#if defined( PRVHASH_DISPATCH_X86 )
+
+	const int f = prvhash_dispatch_features();
+
+	if( strcmp( Name, "avx2" ) == 0 && ( f & PRVHASH_DISPATCH_AVX2 ) != 0 )
+	{
+		return( &prvhash_dispatch_avx2_table );
+	}
+
+	if( strcmp( Name, "avx512" ) == 0 &&
+		( f & PRVHASH_DISPATCH_AVX512 ) != 0 )
+	{
+		return( &prvhash_dispatch_avx512_table );
+	}
+
+#endif // defined( PRVHASH_DISPATCH_X86 )
+
+	return( 0 );
+}
+
+const PRVHASH_DISPATCH* prvhash_dispatch( void )
+{
+	// Concurrent first calls select the same table, so a plain volatile
+	// pointer is sufficient.
+
+	static const PRVHASH_DISPATCH* volatile Table = 0;
+	const PRVHASH_DISPATCH* t = Table;
+
+	if( t == 0 )
+	{
+		t = prvhash_dispatch_find( "avx512" );
+
+		if( t == 0 )
+		{
+			t = prvhash_dispatch_find( "avx2" );
+		}
+
+		if( t == 0 )
+		{
+			t = &prvhash_dispatch_default_table;
+		}
+
+		Table = t;
+	}
+
+	return( t );
+}
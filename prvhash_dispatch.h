@@ -0,0 +1,127 @@
+/**
+ * prvhash_dispatch.h version 4.3.2
+ *
+ * The inclusion file for the optional compiled runtime dispatch module of
+ * PRVHASH functions. The module consists of the "prvhash_dispatch.c",
+ * "prvhash_dispatch_avx2.c" and "prvhash_dispatch_avx512.c" source files,
+ * which should be compiled and linked with the program, without any special
+ * compiler options. The multi-lane PRVHASH core, "prvhash16", "prvhash64",
+ * "prvhash64_64m", "prvhash64s" hash, "tango642" cipher and "prvrng" PRNG
+ * functions are compiled by the module for several instruction sets, via
+ * function target attributes, and the best function table for the processor
+ * is selected on first use. This allows a single program binary to use
+ * AVX-512 or AVX2 instructions where available. On other processors, or if
+ * the module is not used, the header-only functions remain available as
+ * usual, with instruction sets selected at compile time. The Gradilac PRNG
+ * is a C++ class template, and is not a part of the module.
+ *
+ * Description is available at https://github.com/avaneev/prvhash
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PRVHASH_DISPATCH_INCLUDED
+#define PRVHASH_DISPATCH_INCLUDED
+
+#include "prvhash16.h"
+#include "prvhash64.h"
+#include "prvhash64s.h"
+#include "prvrng.h"
+#include "tango642.h"
+
+// PRVHASH_DISPATCH_X86 is defined to 1 if the x86 instruction set tables are
+// compiled.
+
+#if (( defined( __GNUC__ ) || defined( __clang__ )) && \
+	( defined( __x86_64__ ) || defined( __i386__ ))) || \
+	( defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 )))
+
+	#define PRVHASH_DISPATCH_X86 1
+
+#endif // defined( _MSC_VER )
+
+#if defined( __cplusplus )
+extern "C" {
+#endif // defined( __cplusplus )
+
+/**
+ * Function table of the dispatch module. Each function is equal to the
+ * header-only function of the same name, and produces equal results on all
+ * instruction sets.
+ */
+
+typedef struct
+{
+	const char* Name; ///< Instruction set's name, e.g. "avx2".
+	void ( *prvhash_core64_x4 )( uint64_t* Seed0, uint64_t* lcg0,
+		uint64_t* Hash0, uint64_t* out );
+	void ( *prvhash_core64_x8 )( uint64_t* Seed0, uint64_t* lcg0,
+		uint64_t* Hash0, uint64_t* out );
+	void ( *prvhash64 )( const void* Msg0, size_t MsgLen, void* HashOut,
+		size_t HashLen, uint64_t UseSeed );
+	uint64_t ( *prvhash64_64m )( const void* Msg0, size_t MsgLen,
+		uint64_t UseSeed );
+	void ( *prvhash64_64m_batch )( const void* const* Msgs,
+		const size_t* MsgLens, const uint64_t* UseSeeds, uint64_t* HashesOut,
+		size_t Count );
+	void ( *prvhash64s_oneshot )( const void* Msg, size_t MsgLen, void* Hash,
+		size_t HashLen );
+	void ( *tango642_xor )( TANGO642_CTX* ctx, void* msg0, size_t msglen );
+	void ( *prvhash16 )( const void* Msg0, size_t MsgLen, void* Hash0,
+		size_t HashLen, uint32_t UseSeed );
+	void ( *prvhash64s_init )( PRVHASH64S_CTX* ctx, size_t HashLen,
+		const void* UseSeeds );
+	void ( *prvhash64s_update )( PRVHASH64S_CTX* ctx, const void* Msg0,
+		size_t MsgLen );
+	void ( *prvhash64s_final )( PRVHASH64S_CTX* ctx, void* HashOut );
+	int ( *prvrng_init64p2 )( PRVRNG_CTX* ctx );
+	uint64_t ( *prvrng_gen64 )( PRVRNG_CTX* ctx );
+	void ( *prvrng_fill )( PRVRNG_CTX* ctx, void* Buf, size_t Len );
+	void ( *prvrng_final64p2 )( PRVRNG_CTX* ctx );
+} PRVHASH_DISPATCH;
+
+/**
+ * Function returns the function table best suited for the processor. The
+ * table is selected on the first call; the function can be called from
+ * several threads concurrently.
+ */
+
+const PRVHASH_DISPATCH* prvhash_dispatch( void );
+
+/**
+ * Function returns the function table for the specified instruction set.
+ *
+ * @param Name Instruction set's name: "default" (the instruction set the
+ * module was compiled for, without function target attributes), "avx2" or
+ * "avx512".
+ * @return 0 if the instruction set is unknown, or is not supported by the
+ * processor.
+ */
+
+const PRVHASH_DISPATCH* prvhash_dispatch_find( const char* Name );
+
+#if defined( __cplusplus )
+}
+#endif // defined( __cplusplus )
+
+#endif // PRVHASH_DISPATCH_INCLUDED
@@ -0,0 +1,63 @@
+/**
+ * prvhash_dispatch_avx2.c version 4.3.2
+ *
+ * The source file of the PRVHASH runtime dispatch module, which compiles the
+ * function table for the AVX2 instruction set (see prvhash_dispatch.h).
+ *
+ * Description is available at https://github.com/avaneev/prvhash
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// The condition equals the PRVHASH_DISPATCH_X86 macro's condition: this file
+// cannot include "prvhash_dispatch.h" before selecting the instruction set.
+
+#if (( defined( __GNUC__ ) || defined( __clang__ )) && \
+	( defined( __x86_64__ ) || defined( __i386__ ))) || \
+	( defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 )))
+
+#if defined( __clang__ )
+
+	#include <immintrin.h>
+
+	#pragma clang attribute push( __attribute__(( target( "avx2" ))), \
+		apply_to = function )
+
+#elif defined( __GNUC__ )
+
+	#pragma GCC target( "avx2" )
+
+#endif // defined( __GNUC__ )
+
+#define PRVHASH_SIMD 1
+#define PRVHASH_SIMD_AVX2 1
+#define PRVHASH_DISPATCH_FN( n ) prvhash_dispatch_avx2_##n
+#define PRVHASH_DISPATCH_NAME "avx2"
+
+#include "prvhash_dispatch_tpl.h"
+
+#if defined( __clang__ )
+	#pragma clang attribute pop
+#endif // defined( __clang__ )
+
+#endif // defined( _MSC_VER )
@@ -0,0 +1,145 @@
+/**
+ * prvhash_dispatch_tpl.h version 4.3.2
+ *
+ * The template inclusion file of the PRVHASH runtime dispatch module, which
+ * defines the function table for a single instruction set. Should be
+ * included only by the module's source files, after the instruction set was
+ * selected, with PRVHASH_DISPATCH_FN and PRVHASH_DISPATCH_NAME macros
+ * defined.
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "prvhash_simd.h"
+#include "prvhash_dispatch.h"
+
+static void PRVHASH_DISPATCH_FN( core64_x4 )( uint64_t* const Seed0,
+	uint64_t* const lcg0, uint64_t* const Hash0, uint64_t* const out )
+{
+	prvhash_core64_x4( Seed0, lcg0, Hash0, out );
+}
+
+static void PRVHASH_DISPATCH_FN( core64_x8 )( uint64_t* const Seed0,
+	uint64_t* const lcg0, uint64_t* const Hash0, uint64_t* const out )
+{
+	prvhash_core64_x8( Seed0, lcg0, Hash0, out );
+}
+
+static void PRVHASH_DISPATCH_FN( prvhash64 )( const void* const Msg0,
+	const size_t MsgLen, void* const HashOut, const size_t HashLen,
+	const uint64_t UseSeed )
+{
+	prvhash64( Msg0, MsgLen, HashOut, HashLen, UseSeed );
+}
+
+static uint64_t PRVHASH_DISPATCH_FN( prvhash64_64m )( const void* const Msg0,
+	const size_t MsgLen, const uint64_t UseSeed )
+{
+	return( prvhash64_64m( Msg0, MsgLen, UseSeed ));
+}
+
+static void PRVHASH_DISPATCH_FN( prvhash64_64m_batch )(
+	const void* const* const Msgs, const size_t* const MsgLens,
+	const uint64_t* const UseSeeds, uint64_t* const HashesOut,
+	const size_t Count )
+{
+	prvhash64_64m_batch( Msgs, MsgLens, UseSeeds, HashesOut, Count );
+}
+
+static void PRVHASH_DISPATCH_FN( prvhash64s_oneshot )( const void* const Msg,
+	const size_t MsgLen, void* const Hash, const size_t HashLen )
+{
+	prvhash64s_oneshot( Msg, MsgLen, Hash, HashLen );
+}
+
+static void PRVHASH_DISPATCH_FN( tango642_xor )( TANGO642_CTX* const ctx,
+	void* const msg0, const size_t msglen )
+{
+	tango642_xor( ctx, msg0, msglen );
+}
+
+static void PRVHASH_DISPATCH_FN( prvhash16 )( const void* const Msg0,
+	const size_t MsgLen, void* const Hash0, const size_t HashLen,
+	const uint32_t UseSeed )
+{
+	prvhash16( Msg0, MsgLen, Hash0, HashLen, UseSeed );
+}
+
+static void PRVHASH_DISPATCH_FN( prvhash64s_init )(
+	PRVHASH64S_CTX* const ctx, const size_t HashLen,
+	const void* const UseSeeds )
+{
+	prvhash64s_init( ctx, HashLen, UseSeeds );
+}
+
+static void PRVHASH_DISPATCH_FN( prvhash64s_update )(
+	PRVHASH64S_CTX* const ctx, const void* const Msg0, const size_t MsgLen )
+{
+	prvhash64s_update( ctx, Msg0, MsgLen );
+}
+
+static void PRVHASH_DISPATCH_FN( prvhash64s_final )(
+	PRVHASH64S_CTX* const ctx, void* const HashOut )
+{
+	prvhash64s_final( ctx, HashOut );
+}
+
+static int PRVHASH_DISPATCH_FN( prvrng_init64p2 )( PRVRNG_CTX* const ctx )
+{
+	return( prvrng_init64p2( ctx ));
+}
+
+static uint64_t PRVHASH_DISPATCH_FN( prvrng_gen64 )( PRVRNG_CTX* const ctx )
+{
+	return( prvrng_gen64( ctx ));
+}
+
+static void PRVHASH_DISPATCH_FN( prvrng_fill )( PRVRNG_CTX* const ctx,
+	void* const Buf, const size_t Len )
+{
+	prvrng_fill( ctx, Buf, Len );
+}
+
+static void PRVHASH_DISPATCH_FN( prvrng_final64p2 )( PRVRNG_CTX* const ctx )
+{
+	prvrng_final64p2( ctx );
+}
+
+const PRVHASH_DISPATCH PRVHASH_DISPATCH_FN( table ) = {
+	PRVHASH_DISPATCH_NAME,
+	PRVHASH_DISPATCH_FN( core64_x4 ),
+	PRVHASH_DISPATCH_FN( core64_x8 ),
+	PRVHASH_DISPATCH_FN( prvhash64 ),
+	PRVHASH_DISPATCH_FN( prvhash64_64m ),
+	PRVHASH_DISPATCH_FN( prvhash64_64m_batch ),
+	PRVHASH_DISPATCH_FN( prvhash64s_oneshot ),
+	PRVHASH_DISPATCH_FN( tango642_xor ),
+	PRVHASH_DISPATCH_FN( prvhash16 ),
+	PRVHASH_DISPATCH_FN( prvhash64s_init ),
+	PRVHASH_DISPATCH_FN( prvhash64s_update ),
+	PRVHASH_DISPATCH_FN( prvhash64s_final ),
+	PRVHASH_DISPATCH_FN( prvrng_init64p2 ),
+	PRVHASH_DISPATCH_FN( prvrng_gen64 ),
+	PRVHASH_DISPATCH_FN( prvrng_fill ),
+	PRVHASH_DISPATCH_FN( prvrng_final64p2 )
+};
@@ -0,0 +1,1455 @@
+/**
+ * prvhash_map.h version 4.3.0
+ *
+ * The inclusion file for the PrvHashMap and PrvHashSet C++ classes: header-
+ * only open-addressing hash map and hash set ("SwissTable" arrangement),
+ * based on the "prvhash64_64m" hash function. Elements are stored in a
+ * single flat slot array, accompanied by an array of control bytes that are
+ * probed in groups of 16 (SSE2) or 8 (portable) bytes. Each container
+ * instance uses its own hash seed. Requires C++11.
+ *
+ * Description is available at https://github.com/avaneev/prvhash
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PRVHASH_MAP_INCLUDED
+#define PRVHASH_MAP_INCLUDED
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "prvhash64.h"
+
+#if __cplusplus >= 201703L || ( defined( _MSVC_LANG ) && _MSVC_LANG >= 201703L )
+
+	#include <string_view>
+
+	#define PRVHASH_MAP_STRING_VIEW 1
+
+#endif // __cplusplus >= 201703L
+
+// Selection of the control byte group's width. Define the PRVHASH_MAP_NO_SIMD
+// macro to force the use of the portable 8-byte groups.
+
+#if !defined( PRVHASH_MAP_NO_SIMD ) && ( defined( __SSE2__ ) || \
+	defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 ))
+
+	#include <emmintrin.h>
+
+	#define PRVHASH_MAP_SSE2 1
+	#define PRVHASH_MAP_GROUP 16 // Control byte group's width, in bytes.
+	#define PRVHASH_MAP_SHIFT 0 // Match mask's bit shift per control byte.
+
+#else // defined( __SSE2__ )
+
+	#define PRVHASH_MAP_GROUP 8
+	#define PRVHASH_MAP_SHIFT 3
+
+#endif // defined( __SSE2__ )
+
+#define PRVHASH_MAP_EMPTY 0x80 // Control byte of an empty slot.
+#define PRVHASH_MAP_DELETED 0xFE // Control byte of an erased slot.
+
+/**
+ * @return The index of the lowest set bit in the non-zero "v" value.
+ */
+
+static PRVHASH_INLINE int prvhash_map_ctz( const uint64_t v )
+{
+	#if defined( __GNUC__ ) || defined( __clang__ )
+
+		return( __builtin_ctzll( v ));
+
+	#else // defined( __GNUC__ )
+
+		int i = 0;
+		uint64_t m = v;
+
+		while(( m & 1 ) == 0 )
+		{
+			m >>= 1;
+			i++;
+		}
+
+		return( i );
+
+	#endif // defined( __GNUC__ )
+}
+
+/**
+ * Function returns a value usable as a hash seed, which is unique for each
+ * call, and differs between processes (when address space layout
+ * randomization is in use) and program runs. This value is not
+ * cryptographically secure: in open systems, the hash seed should be
+ * obtained from the "prvrng" entropy PRNG instead.
+ *
+ * @param p Any address, e.g., of the container being initialized.
+ */
+
+static inline uint64_t prvhash_map_seed( const void* const p )
+{
+	static std :: atomic< uint64_t > Counter( 0 );
+
+	uint64_t Seed = (uint64_t) (uintptr_t) p;
+	uint64_t lcg = (uint64_t) std :: chrono :: high_resolution_clock ::
+		now().time_since_epoch().count();
+
+	uint64_t Hash = (uint64_t) (uintptr_t) &Counter ^ Counter++;
+	uint64_t v = 0;
+	int i;
+
+	for( i = 0; i < PRVHASH_INIT_COUNT; i++ )
+	{
+		v = prvhash_core64( &Seed, &lcg, &Hash );
+	}
+
+	return( v | 1 );
+}
+
+/**
+ * Arena memory allocator, for PrvHashMap and PrvHashSet slot arrays. Memory
+ * is allocated from large blocks, with an individual allocation not being
+ * freed: all memory is released when the arena is reset or destroyed. The
+ * arena is useful for a large number of small containers with the same
+ * lifetime. Note that slot arrays of the containers that grew are also not
+ * released, and so containers should preferably be reserved for their
+ * expected size. An arena should not be used by several threads
+ * concurrently.
+ */
+
+class PrvHashArena
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * @param aBlockLen The length of memory blocks, in bytes.
+	 */
+
+	explicit PrvHashArena( const size_t aBlockLen = 65536 )
+		: Blocks( 0 )
+		, Pos( 0 )
+		, End( 0 )
+		, BlockLen( aBlockLen )
+	{
+	}
+
+	~PrvHashArena()
+	{
+		reset();
+	}
+
+	/**
+	 * Function allocates memory from the arena.
+	 *
+	 * @param Len The required length, in bytes.
+	 * @param Align The required address alignment, a power of 2, up to 64.
+	 * @return Pointer to the allocated memory. The std::bad_alloc exception
+	 * is thrown if the system is out of memory.
+	 */
+
+	void* alloc( const size_t Len, const size_t Align )
+	{
+		uint8_t* p = align( Pos, Align );
+
+		if( Pos != 0 && p + Len <= End )
+		{
+			Pos = p + Len;
+			return( p );
+		}
+
+		const size_t hl = 64; // Block header's length, keeps alignment.
+
+		if( Len + Align > BlockLen / 2 )
+		{
+			// A large allocation gets its own block, to keep the remaining
+			// space of the current block.
+
+			return( align( newBlock( Len + Align + hl ) + hl, Align ));
+		}
+
+		uint8_t* const b = newBlock( BlockLen );
+		p = align( b + hl, Align );
+		Pos = p + Len;
+		End = b + BlockLen;
+
+		return( p );
+	}
+
+	/**
+	 * Function releases all memory allocated from the arena. Should be called
+	 * only when no container uses the arena.
+	 */
+
+	void reset()
+	{
+		while( Blocks != 0 )
+		{
+			Block* const n = Blocks -> Next;
+			free( Blocks );
+			Blocks = n;
+		}
+
+		Pos = 0;
+		End = 0;
+	}
+
+private:
+	struct Block
+	{
+		Block* Next; ///< The next block in the list.
+	};
+
+	Block* Blocks; ///< The list of allocated blocks.
+	uint8_t* Pos; ///< The next free byte in the current block.
+	uint8_t* End; ///< The end of the current block.
+	size_t BlockLen; ///< The length of memory blocks, in bytes.
+
+	PrvHashArena( const PrvHashArena& ) = delete;
+	PrvHashArena& operator = ( const PrvHashArena& ) = delete;
+
+	static uint8_t* align( uint8_t* const p, const size_t Align )
+	{
+		return( (uint8_t*) (( (uintptr_t) p + Align - 1 ) &
+			~(uintptr_t) ( Align - 1 )));
+	}
+
+	uint8_t* newBlock( const size_t Len )
+	{
+		Block* const b = (Block*) malloc( Len );
+
+		if( b == 0 )
+		{
+			throw std :: bad_alloc();
+		}
+
+		b -> Next = Blocks;
+		Blocks = b;
+
+		return( (uint8_t*) b );
+	}
+};
+
+/**
+ * Trait that checks that the type is a pointer to a character, which is
+ * treated as a C string.
+ */
+
+template< typename t >
+struct PrvHashMapCharPtr
+{
+	static const bool value = std :: is_pointer< t > :: value &&
+		std :: is_same< typename std :: remove_cv< typename
+		std :: remove_pointer< t > :: type > :: type, char > :: value;
+};
+
+/**
+ * Default hasher of the PrvHashMap and PrvHashSet classes, which uses the
+ * "prvhash64_64m" hash function. Supports integer, enumeration and pointer
+ * keys (hashed by value), and std::string, std::string_view and C string
+ * keys (hashed by contents). String types are interchangeable in
+ * heterogeneous lookups. Scalar keys are hashed by their object
+ * representation, and so a key of another scalar type is converted to the
+ * key type before lookup (see PrvHashMapHetero).
+ *
+ * A custom hasher should implement the
+ * "uint64_t operator()( const ktype& k, uint64_t UseSeed ) const" function,
+ * with all 64 bits of good statistical quality.
+ */
+
+struct PrvHashMapHasher
+{
+	typedef void is_transparent; ///< Enables heterogeneous lookup.
+
+	template< typename ktype >
+	typename std :: enable_if< std :: is_integral< ktype > :: value ||
+		std :: is_enum< ktype > :: value || ( std :: is_pointer< ktype > ::
+		value && !PrvHashMapCharPtr< ktype > :: value ), uint64_t > :: type
+	operator()( const ktype& k, const uint64_t UseSeed ) const
+	{
+		return( prvhash64_64m( &k, sizeof( k ), UseSeed ));
+	}
+
+	uint64_t operator()( const std :: string& k,
+		const uint64_t UseSeed ) const
+	{
+		return( prvhash64_64m( k.data(), k.size(), UseSeed ));
+	}
+
+	uint64_t operator()( const char* const k, const uint64_t UseSeed ) const
+	{
+		return( prvhash64_64m( k, strlen( k ), UseSeed ));
+	}
+
+	#if defined( PRVHASH_MAP_STRING_VIEW )
+
+	uint64_t operator()( const std :: string_view k,
+		const uint64_t UseSeed ) const
+	{
+		return( prvhash64_64m( k.data(), k.size(), UseSeed ));
+	}
+
+	#endif // defined( PRVHASH_MAP_STRING_VIEW )
+};
+
+/**
+ * Default key equality predicate of the PrvHashMap and PrvHashSet classes,
+ * uses the "==" operator. Note that C string keys ("const char*") are then
+ * compared as pointers: std::string keys should be used instead, which can
+ * be looked up by C strings.
+ */
+
+struct PrvHashMapEq
+{
+	typedef void is_transparent; ///< Enables heterogeneous lookup.
+
+	template< typename t1, typename t2 >
+	bool operator()( const t1& a, const t2& b ) const
+	{
+		return( a == b );
+	}
+};
+
+/**
+ * Trait that checks that both the hasher and the equality predicate define
+ * the "is_transparent" type, which enables heterogeneous lookup.
+ */
+
+template< typename t, typename = void >
+struct PrvHashMapTransparent
+{
+	static const bool value = false;
+};
+
+template< typename t >
+struct PrvHashMapTransparent< t, typename std :: conditional< true, void,
+	typename t :: is_transparent > :: type >
+{
+	static const bool value = true;
+};
+
+/**
+ * Trait that checks that a key of the "k2" type can be looked up without
+ * conversion to the key type. Requires transparent hasher and equality
+ * predicate. Scalar types other than C strings are excluded: their hashes
+ * depend on the type's size and representation, so that, e.g., "int" and
+ * "uint64_t" keys with equal values would have different hashes.
+ */
+
+template< typename htype, typename etype, typename k2 >
+struct PrvHashMapHetero
+{
+	static const bool value = PrvHashMapTransparent< htype > :: value &&
+		PrvHashMapTransparent< etype > :: value &&
+		( !std :: is_scalar< k2 > :: value ||
+		PrvHashMapCharPtr< k2 > :: value );
+};
+
+/**
+ * A group of control bytes, probed at once. A match function returns a
+ * bit mask, with each matching byte represented by a bit at the
+ * "index << PRVHASH_MAP_SHIFT" position.
+ */
+
+class PrvHashMapGroup
+{
+public:
+	/**
+	 * Constructor loads a group.
+	 *
+	 * @param p Control bytes, aligned to PRVHASH_MAP_GROUP bytes.
+	 */
+
+	explicit PrvHashMapGroup( const uint8_t* const p )
+	{
+		#if defined( PRVHASH_MAP_SSE2 )
+			Ctrl = _mm_load_si128( (const __m128i*) p );
+		#else // defined( PRVHASH_MAP_SSE2 )
+			Ctrl = prvhash_lu64ec( p );
+		#endif // defined( PRVHASH_MAP_SSE2 )
+	}
+
+	/**
+	 * @return The mask of full slots with the specified 7-bit hash value.
+	 * Note that in the portable variant, false positives are possible; they
+	 * are eliminated by key comparison.
+	 */
+
+	uint64_t match( const uint8_t h2 ) const
+	{
+		#if defined( PRVHASH_MAP_SSE2 )
+
+			return( (uint64_t) (uint32_t) _mm_movemask_epi8(
+				_mm_cmpeq_epi8( Ctrl, _mm_set1_epi8( (char) h2 ))));
+
+		#else // defined( PRVHASH_MAP_SSE2 )
+
+			const uint64_t Lsbs = 0x0101010101010101;
+			const uint64_t x = Ctrl ^ ( Lsbs * h2 );
+
+			return(( x - Lsbs ) & ~x & ( Lsbs << 7 ));
+
+		#endif // defined( PRVHASH_MAP_SSE2 )
+	}
+
+	/**
+	 * @return The mask of empty slots.
+	 */
+
+	uint64_t matchEmpty() const
+	{
+		#if defined( PRVHASH_MAP_SSE2 )
+
+			return( (uint64_t) (uint32_t) _mm_movemask_epi8( _mm_cmpeq_epi8(
+				Ctrl, _mm_set1_epi8( (char) PRVHASH_MAP_EMPTY ))));
+
+		#else // defined( PRVHASH_MAP_SSE2 )
+
+			return( Ctrl & ~( Ctrl << 6 ) & 0x8080808080808080 );
+
+		#endif // defined( PRVHASH_MAP_SSE2 )
+	}
+
+	/**
+	 * @return The mask of empty and erased slots.
+	 */
+
+	uint64_t matchFree() const
+	{
+		#if defined( PRVHASH_MAP_SSE2 )
+			return( (uint64_t) (uint32_t) _mm_movemask_epi8( Ctrl ));
+		#else // defined( PRVHASH_MAP_SSE2 )
+			return( Ctrl & 0x8080808080808080 );
+		#endif // defined( PRVHASH_MAP_SSE2 )
+	}
+
+private:
+	#if defined( PRVHASH_MAP_SSE2 )
+		__m128i Ctrl; ///< Control bytes.
+	#else // defined( PRVHASH_MAP_SSE2 )
+		uint64_t Ctrl; ///< Control bytes, in little-endian order.
+	#endif // defined( PRVHASH_MAP_SSE2 )
+};
+
+/**
+ * Open-addressing hash table, the base of the PrvHashMap and PrvHashSet
+ * classes.
+ *
+ * The table's capacity is a power of 2, and it is divided into groups of
+ * PRVHASH_MAP_GROUP slots. The lower 7 bits of a key's hash are stored in
+ * a control byte of a full slot, the remaining bits select the first probed
+ * group; groups are then probed in the triangular sequence, until a group
+ * with an empty slot is met. The load factor, including erased slots, is
+ * kept below 7/8.
+ *
+ * Insertions may rehash the table, which invalidates all iterators and
+ * references. Erasures invalidate only iterators and references to the
+ * erased elements. Keys of elements must not be changed via iterators.
+ *
+ * @tparam vtype Element type.
+ * @tparam ktype Key type.
+ * @tparam kof Key extractor, with the static "key( const vtype& )" function.
+ * @tparam htype Hasher type.
+ * @tparam etype Key equality predicate type.
+ */
+
+template< typename vtype, typename ktype, typename kof, typename htype,
+	typename etype >
+class PrvHashTable
+{
+public:
+	typedef ktype key_type; ///< Key type.
+	typedef vtype value_type; ///< Element type.
+	typedef size_t size_type; ///< Size type.
+	typedef htype hasher; ///< Hasher type.
+	typedef etype key_equal; ///< Key equality predicate type.
+
+	/**
+	 * Iterator over full slots of the table.
+	 *
+	 * @tparam itype Element type, "vtype" or "const vtype".
+	 */
+
+	template< typename itype >
+	class iter
+	{
+		friend class PrvHashTable;
+
+	public:
+		typedef std :: forward_iterator_tag iterator_category;
+		typedef itype value_type;
+		typedef ptrdiff_t difference_type;
+		typedef itype* pointer;
+		typedef itype& reference;
+
+		iter()
+			: c( 0 )
+			, ce( 0 )
+			, s( 0 )
+		{
+		}
+
+		/**
+		 * Constructor converts an "iterator" into a "const_iterator".
+		 */
+
+		template< typename i2 >
+		iter( const iter< i2 >& i, typename std :: enable_if<
+			std :: is_convertible< i2*, itype* > :: value > :: type* = 0 )
+			: c( i.c )
+			, ce( i.ce )
+			, s( i.s )
+		{
+		}
+
+		itype& operator * () const
+		{
+			return( *s );
+		}
+
+		itype* operator -> () const
+		{
+			return( s );
+		}
+
+		iter& operator ++ ()
+		{
+			c++;
+			s++;
+			skip();
+
+			return( *this );
+		}
+
+		iter operator ++ ( int )
+		{
+			const iter t = *this;
+			++( *this );
+
+			return( t );
+		}
+
+		template< typename i2 >
+		bool operator == ( const iter< i2 >& i ) const
+		{
+			return( c == i.c );
+		}
+
+		template< typename i2 >
+		bool operator != ( const iter< i2 >& i ) const
+		{
+			return( c != i.c );
+		}
+
+	private:
+		template< typename i2 >
+		friend class iter;
+
+		const uint8_t* c; ///< Current control byte.
+		const uint8_t* ce; ///< The end of control bytes.
+		itype* s; ///< Current slot.
+
+		iter( const uint8_t* const ac, const uint8_t* const ace,
+			itype* const as )
+			: c( ac )
+			, ce( ace )
+			, s( as )
+		{
+		}
+
+		/**
+		 * Function skips free slots.
+		 */
+
+		void skip()
+		{
+			while( c != ce && ( *c & 0x80 ) != 0 )
+			{
+				c++;
+				s++;
+			}
+		}
+	};
+
+	typedef iter< vtype > iterator; ///< Iterator type.
+	typedef iter< const vtype > const_iterator; ///< Constant iterator type.
+
+	/**
+	 * Constructor. Memory is not allocated until the first insertion.
+	 *
+	 * @param UseSeed Hash seed, 0 - use a per-instance seed obtained via the
+	 * prvhash_map_seed() function. In open systems, to resist "HashDoS"
+	 * attacks, a random value should be supplied, e.g., produced by the
+	 * "prvrng" entropy PRNG.
+	 * @param aArena Arena to allocate slot arrays from, 0 - use "malloc".
+	 * The arena should outlive the container.
+	 */
+
+	explicit PrvHashTable( const uint64_t UseSeed = 0,
+		PrvHashArena* const aArena = 0 )
+		: Ctrl( 0 )
+		, Slots( 0 )
+		, Mem( 0 )
+		, Cap( 0 )
+		, Size( 0 )
+		, Deleted( 0 )
+		, Seed( UseSeed != 0 ? UseSeed : prvhash_map_seed( this ))
+		, Arena( aArena )
+	{
+	}
+
+	/**
+	 * Copy constructor. The copy uses the same hash seed and arena, and the
+	 * same slot layout.
+	 */
+
+	PrvHashTable( const PrvHashTable& s )
+		: Ctrl( 0 )
+		, Slots( 0 )
+		, Mem( 0 )
+		, Cap( 0 )
+		, Size( 0 )
+		, Deleted( 0 )
+		, Seed( s.Seed )
+		, Arena( s.Arena )
+	{
+		if( s.Size == 0 )
+		{
+			return;
+		}
+
+		allocate( s.Cap );
+
+		size_t i;
+
+		try
+		{
+			for( i = 0; i < Cap; i++ )
+			{
+				if(( s.Ctrl[ i ] & 0x80 ) == 0 )
+				{
+					new( Slots + i ) vtype( s.Slots[ i ]);
+					Ctrl[ i ] = s.Ctrl[ i ];
+					Size++;
+				}
+			}
+		}
+		catch( ... )
+		{
+			release();
+			throw;
+		}
+
+		// Erased slots are kept, as they may continue probe sequences.
+
+		for( i = 0; i < Cap; i++ )
+		{
+			if( s.Ctrl[ i ] == PRVHASH_MAP_DELETED )
+			{
+				Ctrl[ i ] = PRVHASH_MAP_DELETED;
+				Deleted++;
+			}
+		}
+	}
+
+	PrvHashTable( PrvHashTable&& s )
+		: Ctrl( s.Ctrl )
+		, Slots( s.Slots )
+		, Mem( s.Mem )
+		, Cap( s.Cap )
+		, Size( s.Size )
+		, Deleted( s.Deleted )
+		, Seed( s.Seed )
+		, Arena( s.Arena )
+	{
+		s.Ctrl = 0;
+		s.Slots = 0;
+		s.Mem = 0;
+		s.Cap = 0;
+		s.Size = 0;
+		s.Deleted = 0;
+	}
+
+	~PrvHashTable()
+	{
+		release();
+	}
+
+	PrvHashTable& operator = ( const PrvHashTable& s )
+	{
+		if( this != &s )
+		{
+			PrvHashTable t( s );
+			swap( t );
+		}
+
+		return( *this );
+	}
+
+	PrvHashTable& operator = ( PrvHashTable&& s )
+	{
+		swap( s );
+
+		return( *this );
+	}
+
+	/**
+	 * Function swaps the contents, hash seeds and arenas of two containers.
+	 */
+
+	void swap( PrvHashTable& s )
+	{
+		std :: swap( Ctrl, s.Ctrl );
+		std :: swap( Slots, s.Slots );
+		std :: swap( Mem, s.Mem );
+		std :: swap( Cap, s.Cap );
+		std :: swap( Size, s.Size );
+		std :: swap( Deleted, s.Deleted );
+		std :: swap( Seed, s.Seed );
+		std :: swap( Arena, s.Arena );
+	}
+
+	iterator begin()
+	{
+		iterator i( Ctrl, Ctrl + Cap, Slots );
+		i.skip();
+
+		return( i );
+	}
+
+	const_iterator begin() const
+	{
+		const_iterator i( Ctrl, Ctrl + Cap, Slots );
+		i.skip();
+
+		return( i );
+	}
+
+	iterator end()
+	{
+		return( iterator( Ctrl + Cap, Ctrl + Cap, Slots + Cap ));
+	}
+
+	const_iterator end() const
+	{
+		return( const_iterator( Ctrl + Cap, Ctrl + Cap, Slots + Cap ));
+	}
+
+	/**
+	 * @return The number of elements in the container.
+	 */
+
+	size_t size() const
+	{
+		return( Size );
+	}
+
+	bool empty() const
+	{
+		return( Size == 0 );
+	}
+
+	/**
+	 * @return The number of slots in the table.
+	 */
+
+	size_t capacity() const
+	{
+		return( Cap );
+	}
+
+	/**
+	 * @return The hash seed in use.
+	 */
+
+	uint64_t seed() const
+	{
+		return( Seed );
+	}
+
+	/**
+	 * Function removes all elements, keeping the table's capacity.
+	 */
+
+	void clear()
+	{
+		destroyAll();
+
+		if( Cap != 0 )
+		{
+			memset( Ctrl, PRVHASH_MAP_EMPTY, Cap );
+		}
+
+		Size = 0;
+		Deleted = 0;
+	}
+
+	/**
+	 * Function makes sure the specified number of elements can be inserted
+	 * without rehashing.
+	 *
+	 * @param n The number of elements.
+	 */
+
+	void reserve( const size_t n )
+	{
+		const size_t c = capFor( n );
+
+		if( c > Cap )
+		{
+			rehash( c );
+		}
+	}
+
+	/**
+	 * @return Iterator to the element with the specified key, or end().
+	 */
+
+	iterator find( const ktype& k )
+	{
+		return( iterAt( findIndex( k )));
+	}
+
+	const_iterator find( const ktype& k ) const
+	{
+		return( iterAt( findIndex( k )));
+	}
+
+	/**
+	 * Function finds an element by a key of another type, which should be
+	 * comparable with the key type, and should have the same hash as the
+	 * equal key. Requires transparent hasher and equality predicate; keys of
+	 * other scalar types are converted to the key type (see
+	 * PrvHashMapHetero).
+	 *
+	 * @return Iterator to the element with the specified key, or end().
+	 */
+
+	template< typename k2, typename std :: enable_if<
+		PrvHashMapHetero< htype, etype, k2 > :: value, int > :: type = 0 >
+	iterator find( const k2& k )
+	{
+		return( iterAt( findIndex( k )));
+	}
+
+	template< typename k2, typename std :: enable_if<
+		PrvHashMapHetero< htype, etype, k2 > :: value, int > :: type = 0 >
+	const_iterator find( const k2& k ) const
+	{
+		return( iterAt( findIndex( k )));
+	}
+
+	/**
+	 * @return 1 if the element with the specified key exists, 0 otherwise.
+	 */
+
+	size_t count( const ktype& k ) const
+	{
+		return( findIndex( k ) != Cap );
+	}
+
+	template< typename k2, typename std :: enable_if<
+		PrvHashMapHetero< htype, etype, k2 > :: value, int > :: type = 0 >
+	size_t count( const k2& k ) const
+	{
+		return( findIndex( k ) != Cap );
+	}
+
+	bool contains( const ktype& k ) const
+	{
+		return( findIndex( k ) != Cap );
+	}
+
+	template< typename k2, typename std :: enable_if<
+		PrvHashMapHetero< htype, etype, k2 > :: value, int > :: type = 0 >
+	bool contains( const k2& k ) const
+	{
+		return( findIndex( k ) != Cap );
+	}
+
+	/**
+	 * Function inserts an element, if an element with the same key does not
+	 * exist.
+	 *
+	 * @return Iterator to the element with the element's key, and "true" if
+	 * the element was inserted.
+	 */
+
+	std :: pair< iterator, bool > insert( const vtype& v )
+	{
+		return( emplaceKey( kof :: key( v ), v ));
+	}
+
+	std :: pair< iterator, bool > insert( vtype&& v )
+	{
+		return( emplaceKey( kof :: key( v ), std :: move( v )));
+	}
+
+	/**
+	 * Function constructs an element from the specified arguments, and
+	 * inserts it, if an element with the same key does not exist.
+	 *
+	 * @return Iterator to the element with the element's key, and "true" if
+	 * the element was inserted.
+	 */
+
+	template< typename... atypes >
+	std :: pair< iterator, bool > emplace( atypes&&... args )
+	{
+		vtype v( std :: forward< atypes >( args )... );
+
+		return( emplaceKey( kof :: key( v ), std :: move( v )));
+	}
+
+	/**
+	 * Function erases the element with the specified key.
+	 *
+	 * @return The number of erased elements, 0 or 1.
+	 */
+
+	size_t erase( const ktype& k )
+	{
+		return( eraseIndex( findIndex( k )));
+	}
+
+	template< typename k2, typename std :: enable_if<
+		PrvHashMapHetero< htype, etype, k2 > :: value, int > :: type = 0 >
+	size_t erase( const k2& k )
+	{
+		return( eraseIndex( findIndex( k )));
+	}
+
+	/**
+	 * Function erases the element at the specified position.
+	 *
+	 * @param i Iterator to the element.
+	 * @return Iterator to the next element.
+	 */
+
+	iterator erase( const const_iterator i )
+	{
+		const size_t si = (size_t) ( i.c - Ctrl );
+		eraseIndex( si );
+
+		iterator n( Ctrl + si, Ctrl + Cap, Slots + si );
+		++n;
+
+		return( n );
+	}
+
+	iterator erase( const iterator i )
+	{
+		return( erase( const_iterator( i )));
+	}
+
+protected:
+	uint8_t* Ctrl; ///< Control bytes, Cap items.
+	vtype* Slots; ///< Slots, Cap items.
+	void* Mem; ///< Allocated memory block, if "malloc" was used.
+	size_t Cap; ///< The number of slots, 0 or a power of 2.
+	size_t Size; ///< The number of full slots.
+	size_t Deleted; ///< The number of erased slots.
+	uint64_t Seed; ///< Hash seed.
+	PrvHashArena* Arena; ///< Arena to allocate from, or 0.
+
+	/**
+	 * @return The maximal number of full and erased slots, for the specified
+	 * capacity.
+	 */
+
+	static size_t maxLoad( const size_t c )
+	{
+		return( c - c / 8 );
+	}
+
+	/**
+	 * @return Capacity required to hold "n" elements without rehashing.
+	 */
+
+	static size_t capFor( const size_t n )
+	{
+		size_t c = PRVHASH_MAP_GROUP;
+
+		while( maxLoad( c ) <= n )
+		{
+			c *= 2;
+		}
+
+		return( c );
+	}
+
+	/**
+	 * @return The hash of the specified key.
+	 */
+
+	template< typename k2 >
+	uint64_t hash( const k2& k ) const
+	{
+		return( htype()( k, Seed ));
+	}
+
+	iterator iterAt( const size_t i )
+	{
+		return( iterator( Ctrl + i, Ctrl + Cap, Slots + i ));
+	}
+
+	const_iterator iterAt( const size_t i ) const
+	{
+		return( const_iterator( Ctrl + i, Ctrl + Cap, Slots + i ));
+	}
+
+	/**
+	 * Function finds the slot of the element with the specified key.
+	 *
+	 * @param k Key.
+	 * @param h Key's hash.
+	 * @return Slot's index, or Cap if not found.
+	 */
+
+	template< typename k2 >
+	size_t findIndex( const k2& k, const uint64_t h ) const
+	{
+		const size_t gm = Cap / PRVHASH_MAP_GROUP - 1;
+		const uint8_t h2 = (uint8_t) ( h & 0x7F );
+		size_t g = (size_t) ( h >> 7 ) & gm;
+		size_t step = 0;
+
+		while( true )
+		{
+			const size_t gs = g * PRVHASH_MAP_GROUP;
+			const PrvHashMapGroup grp( Ctrl + gs );
+			uint64_t m;
+
+			for( m = grp.match( h2 ); m != 0; m &= m - 1 )
+			{
+				const size_t i = gs +
+					(size_t) ( prvhash_map_ctz( m ) >> PRVHASH_MAP_SHIFT );
+
+				if( etype()( kof :: key( Slots[ i ]), k ))
+				{
+					return( i );
+				}
+			}
+
+			if( grp.matchEmpty() != 0 )
+			{
+				return( Cap );
+			}
+
+			g = ( g + ++step ) & gm;
+		}
+	}
+
+	template< typename k2 >
+	size_t findIndex( const k2& k ) const
+	{
+		if( Size == 0 )
+		{
+			return( Cap );
+		}
+
+		return( findIndex( k, hash( k )));
+	}
+
+	/**
+	 * Function finds the first empty or erased slot in the probe sequence
+	 * of the specified hash.
+	 *
+	 * @return Slot's index.
+	 */
+
+	size_t findFree( const uint64_t h ) const
+	{
+		const size_t gm = Cap / PRVHASH_MAP_GROUP - 1;
+		size_t g = (size_t) ( h >> 7 ) & gm;
+		size_t step = 0;
+
+		while( true )
+		{
+			const size_t gs = g * PRVHASH_MAP_GROUP;
+			const uint64_t m = PrvHashMapGroup( Ctrl + gs ).matchFree();
+
+			if( m != 0 )
+			{
+				return( gs +
+					(size_t) ( prvhash_map_ctz( m ) >> PRVHASH_MAP_SHIFT ));
+			}
+
+			g = ( g + ++step ) & gm;
+		}
+	}
+
+	/**
+	 * Function inserts an element with the specified key, constructed from
+	 * the specified arguments, if the key does not exist.
+	 *
+	 * @return Iterator to the element with the key, and "true" if the
+	 * element was inserted.
+	 */
+
+	template< typename k2, typename... atypes >
+	std :: pair< iterator, bool > emplaceKey( const k2& k,
+		atypes&&... args )
+	{
+		const uint64_t h = hash( k );
+
+		if( Size != 0 )
+		{
+			const size_t i = findIndex( k, h );
+
+			if( i != Cap )
+			{
+				return( std :: make_pair( iterAt( i ), false ));
+			}
+		}
+
+		if( Size + Deleted >= maxLoad( Cap ))
+		{
+			grow();
+		}
+
+		const size_t i = findFree( h );
+		new( Slots + i ) vtype( std :: forward< atypes >( args )... );
+
+		Deleted -= ( Ctrl[ i ] == PRVHASH_MAP_DELETED );
+		Ctrl[ i ] = (uint8_t) ( h & 0x7F );
+		Size++;
+
+		return( std :: make_pair( iterAt( i ), true ));
+	}
+
+	/**
+	 * Function erases the element in the specified slot.
+	 *
+	 * @param i Slot's index, or Cap.
+	 * @return 1 if the element was erased, 0 if "i" equals Cap.
+	 */
+
+	size_t eraseIndex( const size_t i )
+	{
+		if( i == Cap )
+		{
+			return( 0 );
+		}
+
+		Slots[ i ].~vtype();
+		Size--;
+
+		// The slot can be marked empty if its group has an empty slot: then
+		// no probe sequence continues past this group.
+
+		const size_t gs = i & ~(size_t) ( PRVHASH_MAP_GROUP - 1 );
+
+		if( PrvHashMapGroup( Ctrl + gs ).matchEmpty() != 0 )
+		{
+			Ctrl[ i ] = PRVHASH_MAP_EMPTY;
+		}
+		else
+		{
+			Ctrl[ i ] = PRVHASH_MAP_DELETED;
+			Deleted++;
+		}
+
+		return( 1 );
+	}
+
+	/**
+	 * Function increases the table's capacity, or only rehashes the table if
+	 * a large number of slots were erased.
+	 */
+
+	void grow()
+	{
+		if( Cap == 0 )
+		{
+			rehash( PRVHASH_MAP_GROUP );
+		}
+		else
+		{
+			rehash( Deleted >= Cap / 4 ? Cap : Cap * 2 );
+		}
+	}
+
+	/**
+	 * Function moves all elements to a new table.
+	 *
+	 * @param NewCap New capacity, a power of 2, >= PRVHASH_MAP_GROUP, should
+	 * fit all elements.
+	 */
+
+	void rehash( const size_t NewCap )
+	{
+		uint8_t* const oc = Ctrl;
+		vtype* const os = Slots;
+		void* const om = Mem;
+		const size_t ocap = Cap;
+
+		allocate( NewCap );
+		Deleted = 0;
+
+		size_t i;
+
+		for( i = 0; i < ocap; i++ )
+		{
+			if(( oc[ i ] & 0x80 ) == 0 )
+			{
+				const size_t j = findFree( hash( kof :: key( os[ i ])));
+
+				new( Slots + j ) vtype( std :: move( os[ i ]));
+				os[ i ].~vtype();
+				Ctrl[ j ] = oc[ i ];
+			}
+		}
+
+		free( om );
+	}
+
+	/**
+	 * Function allocates an empty table, without releasing the previous one.
+	 *
+	 * @param NewCap New capacity, a power of 2, >= PRVHASH_MAP_GROUP.
+	 */
+
+	void allocate( const size_t NewCap )
+	{
+		const size_t sa = ( alignof( vtype ) > 16 ? alignof( vtype ) : 16 );
+		const size_t so = ( NewCap + sa - 1 ) & ~( sa - 1 );
+		const size_t Len = so + NewCap * sizeof( vtype );
+		uint8_t* p;
+
+		if( Arena != 0 )
+		{
+			p = (uint8_t*) Arena -> alloc( Len, sa );
+			Mem = 0;
+		}
+		else
+		{
+			Mem = malloc( Len + sa );
+
+			if( Mem == 0 )
+			{
+				throw std :: bad_alloc();
+			}
+
+			p = (uint8_t*) (( (uintptr_t) Mem + sa - 1 ) &
+				~(uintptr_t) ( sa - 1 ));
+		}
+
+		Ctrl = p;
+		Slots = (vtype*) ( p + so );
+		Cap = NewCap;
+
+		memset( Ctrl, PRVHASH_MAP_EMPTY, Cap );
+	}
+
+	/**
+	 * Function destroys all elements, without changing control bytes.
+	 */
+
+	void destroyAll()
+	{
+		if( !std :: is_trivially_destructible< vtype > :: value )
+		{
+			size_t i;
+
+			for( i = 0; i < Cap; i++ )
+			{
+				if(( Ctrl[ i ] & 0x80 ) == 0 )
+				{
+					Slots[ i ].~vtype();
+				}
+			}
+		}
+	}
+
+	/**
+	 * Function destroys all elements, and releases the table.
+	 */
+
+	void release()
+	{
+		destroyAll();
+		free( Mem );
+
+		Ctrl = 0;
+		Slots = 0;
+		Mem = 0;
+		Cap = 0;
+		Size = 0;
+		Deleted = 0;
+	}
+};
+
+/**
+ * Key extractor of the PrvHashMap class.
+ */
+
+template< typename ktype, typename mtype >
+struct PrvHashMapKeyOf
+{
+	static const ktype& key( const std :: pair< ktype, mtype >& v )
+	{
+		return( v.first );
+	}
+};
+
+/**
+ * Key extractor of the PrvHashSet class.
+ */
+
+template< typename ktype >
+struct PrvHashSetKeyOf
+{
+	static const ktype& key( const ktype& v )
+	{
+		return( v );
+	}
+};
+
+/**
+ * Hash map, with "std::unordered_map"-like interface. Elements are stored
+ * as "std::pair< ktype, mtype >" values in a flat slot array, see the
+ * PrvHashTable class for details.
+ *
+ * @tparam ktype Key type.
+ * @tparam mtype Mapped value type.
+ * @tparam htype Hasher type.
+ * @tparam etype Key equality predicate type.
+ */
+
+template< typename ktype, typename mtype, typename htype = PrvHashMapHasher,
+	typename etype = PrvHashMapEq >
+class PrvHashMap : public PrvHashTable< std :: pair< ktype, mtype >, ktype,
+	PrvHashMapKeyOf< ktype, mtype >, htype, etype >
+{
+public:
+	typedef PrvHashTable< std :: pair< ktype, mtype >, ktype,
+		PrvHashMapKeyOf< ktype, mtype >, htype, etype > base; ///< Base.
+
+	typedef mtype mapped_type; ///< Mapped value type.
+
+	using base :: base;
+
+	/**
+	 * Function inserts an element with the specified key and the mapped
+	 * value constructed from the specified arguments, if the key does not
+	 * exist. Arguments are not used if the key exists.
+	 *
+	 * @return Iterator to the element with the key, and "true" if the
+	 * element was inserted.
+	 */
+
+	template< typename... atypes >
+	std :: pair< typename base :: iterator, bool > try_emplace(
+		const ktype& k, atypes&&... args )
+	{
+		return( this -> emplaceKey( k, std :: piecewise_construct,
+			std :: forward_as_tuple( k ),
+			std :: forward_as_tuple( std :: forward< atypes >( args )... )));
+	}
+
+	template< typename... atypes >
+	std :: pair< typename base :: iterator, bool > try_emplace( ktype&& k,
+		atypes&&... args )
+	{
+		return( this -> emplaceKey( k, std :: piecewise_construct,
+			std :: forward_as_tuple( std :: move( k )),
+			std :: forward_as_tuple( std :: forward< atypes >( args )... )));
+	}
+
+	/**
+	 * @return Reference to the mapped value of the specified key; a
+	 * value-initialized mapped value is inserted if the key does not exist.
+	 */
+
+	mtype& operator []( const ktype& k )
+	{
+		return( try_emplace( k ).first -> second );
+	}
+
+	mtype& operator []( ktype&& k )
+	{
+		return( try_emplace( std :: move( k )).first -> second );
+	}
+
+	/**
+	 * @return Reference to the mapped value of the specified key. The
+	 * std::out_of_range exception is thrown if the key does not exist.
+	 */
+
+	mtype& at( const ktype& k )
+	{
+		const typename base :: iterator i = this -> find( k );
+
+		if( i == this -> end() )
+		{
+			throw std :: out_of_range( "PrvHashMap::at" );
+		}
+
+		return( i -> second );
+	}
+
+	const mtype& at( const ktype& k ) const
+	{
+		const typename base :: const_iterator i = this -> find( k );
+
+		if( i == this -> end() )
+		{
+			throw std :: out_of_range( "PrvHashMap::at" );
+		}
+
+		return( i -> second );
+	}
+};
+
+/**
+ * Hash set, with "std::unordered_set"-like interface. Keys are stored in a
+ * flat slot array, see the PrvHashTable class for details.
+ *
+ * @tparam ktype Key type.
+ * @tparam htype Hasher type.
+ * @tparam etype Key equality predicate type.
+ */
+
+template< typename ktype, typename htype = PrvHashMapHasher,
+	typename etype = PrvHashMapEq >
+class PrvHashSet : public PrvHashTable< ktype, ktype,
+	PrvHashSetKeyOf< ktype >, htype, etype >
+{
+public:
+	typedef PrvHashTable< ktype, ktype, PrvHashSetKeyOf< ktype >, htype,
+		etype > base; ///< Base.
+
+	using base :: base;
+};
+
+#endif // PRVHASH_MAP_INCLUDED
@@ -0,0 +1,341 @@
+/**
+ * prvhash_simd.h version 4.3.2
+ *
+ * The inclusion file for the "prvhash_core64_xN" multi-lane PRVHASH core
+ * functions. These functions run several independent PRVHASH systems at
+ * once, using SIMD instructions where available, and produce results that
+ * are bit-exact with the scalar "prvhash_core64" function.
+ *
+ * Description is available at https://github.com/avaneev/prvhash
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PRVHASH_SIMD_INCLUDED
+#define PRVHASH_SIMD_INCLUDED
+
+#include "prvhash_core.h"
+
+// Compile-time selection of the SIMD instruction set. Define the
+// PRVHASH_SIMD_DISABLE macro to force the use of the scalar core function.
+// The PRVHASH_SIMD macro is defined to 1 if any SIMD path is in use. An
+// instruction set can be also selected explicitly, by defining PRVHASH_SIMD
+// and one of the PRVHASH_SIMD_AVX512, PRVHASH_SIMD_AVX2 or PRVHASH_SIMD_NEON
+// macros, for compilation with function target attributes (see
+// prvhash_dispatch.h).
+
+#if defined( PRVHASH_SIMD )
+
+	#if defined( PRVHASH_SIMD_NEON )
+		#include <arm_neon.h>
+	#else // defined( PRVHASH_SIMD_NEON )
+		#include <immintrin.h>
+	#endif // defined( PRVHASH_SIMD_NEON )
+
+#elif !defined( PRVHASH_SIMD_DISABLE )
+
+	#if defined( __AVX512F__ ) && defined( __AVX512DQ__ ) && \
+		defined( __AVX512VL__ )
+
+		#include <immintrin.h>
+
+		#define PRVHASH_SIMD 1
+		#define PRVHASH_SIMD_AVX512 1
+
+	#elif defined( __AVX2__ )
+
+		#include <immintrin.h>
+
+		#define PRVHASH_SIMD 1
+		#define PRVHASH_SIMD_AVX2 1
+
+	#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+
+		#include <arm_neon.h>
+
+		#define PRVHASH_SIMD 1
+		#define PRVHASH_SIMD_NEON 1
+
+	#endif // defined( __ARM_NEON )
+
+#endif // defined( PRVHASH_SIMD )
+
+#if defined( PRVHASH_SIMD_AVX512 ) || defined( PRVHASH_SIMD_AVX2 )
+
+/**
+ * An auxiliary function that multiplies 4 unsigned 64-bit values, returning
+ * the lower 64 bits of each product. The AVX2 instruction set lacks such
+ * instruction, and so the product is assembled out of 32x32-bit products.
+ *
+ * @param a Multiplicands.
+ * @param b Multipliers.
+ */
+
+static PRVHASH_INLINE __m256i prvhash_mul64_x4( const __m256i a,
+	const __m256i b )
+{
+	#if defined( PRVHASH_SIMD_AVX512 )
+
+		return( _mm256_mullo_epi64( a, b ));
+
+	#else // defined( PRVHASH_SIMD_AVX512 )
+
+		const __m256i c = _mm256_mullo_epi32( a,
+			_mm256_shuffle_epi32( b, 0xB1 ));
+
+		const __m256i cs = _mm256_add_epi32( c, _mm256_srli_epi64( c, 32 ));
+
+		return( _mm256_add_epi64( _mm256_mul_epu32( a, b ),
+			_mm256_slli_epi64( cs, 32 )));
+
+	#endif // defined( PRVHASH_SIMD_AVX512 )
+}
+
+/**
+ * Vector (register-level) variant of the "prvhash_core64" function, for 4
+ * independent PRVHASH systems.
+ *
+ * @param[in,out] Seed0 The current "Seed" values.
+ * @param[in,out] lcg0 The current "lcg" values.
+ * @param[in,out] Hash0 Current hash words.
+ * @return Current random values.
+ */
+
+static PRVHASH_INLINE __m256i prvhash_core64_v4( __m256i* const Seed0,
+	__m256i* const lcg0, __m256i* const Hash0 )
+{
+	const __m256i one = _mm256_set1_epi64x( 1 );
+	const __m256i ca = _mm256_set1_epi64x( (int64_t) 0xAAAAAAAAAAAAAAAA );
+	const __m256i c5 = _mm256_set1_epi64x( (int64_t) 0x5555555555555555 );
+
+	__m256i Seed = *Seed0; __m256i lcg = *lcg0; __m256i Hash = *Hash0;
+
+	Seed = prvhash_mul64_x4( Seed,
+		_mm256_add_epi64( _mm256_add_epi64( lcg, lcg ), one ));
+
+	#if defined( PRVHASH_SIMD_AVX512 )
+		const __m256i rs = _mm256_ror_epi64( Seed, 32 );
+	#else // defined( PRVHASH_SIMD_AVX512 )
+		const __m256i rs = _mm256_shuffle_epi32( Seed, 0xB1 );
+	#endif // defined( PRVHASH_SIMD_AVX512 )
+
+	Hash = _mm256_add_epi64( Hash, _mm256_add_epi64( rs, ca ));
+	lcg = _mm256_add_epi64( lcg, _mm256_add_epi64( Seed, c5 ));
+	Seed = _mm256_xor_si256( Seed, Hash );
+	const __m256i out = _mm256_xor_si256( lcg, rs );
+
+	*Seed0 = Seed; *lcg0 = lcg; *Hash0 = Hash;
+
+	return( out );
+}
+
+#endif // defined( PRVHASH_SIMD_AVX512 ) || defined( PRVHASH_SIMD_AVX2 )
+
+#if defined( PRVHASH_SIMD_AVX512 )
+
+/**
+ * Vector (register-level) variant of the "prvhash_core64" function, for 8
+ * independent PRVHASH systems.
+ *
+ * @param[in,out] Seed0 The current "Seed" values.
+ * @param[in,out] lcg0 The current "lcg" values.
+ * @param[in,out] Hash0 Current hash words.
+ * @return Current random values.
+ */
+
+static PRVHASH_INLINE __m512i prvhash_core64_v8( __m512i* const Seed0,
+	__m512i* const lcg0, __m512i* const Hash0 )
+{
+	const __m512i one = _mm512_set1_epi64( 1 );
+	const __m512i ca = _mm512_set1_epi64( (int64_t) 0xAAAAAAAAAAAAAAAA );
+	const __m512i c5 = _mm512_set1_epi64( (int64_t) 0x5555555555555555 );
+
+	__m512i Seed = *Seed0; __m512i lcg = *lcg0; __m512i Hash = *Hash0;
+
+	Seed = _mm512_mullo_epi64( Seed,
+		_mm512_add_epi64( _mm512_add_epi64( lcg, lcg ), one ));
+
+	const __m512i rs = _mm512_ror_epi64( Seed, 32 );
+	Hash = _mm512_add_epi64( Hash, _mm512_add_epi64( rs, ca ));
+	lcg = _mm512_add_epi64( lcg, _mm512_add_epi64( Seed, c5 ));
+	Seed = _mm512_xor_si512( Seed, Hash );
+	const __m512i out = _mm512_xor_si512( lcg, rs );
+
+	*Seed0 = Seed; *lcg0 = lcg; *Hash0 = Hash;
+
+	return( out );
+}
+
+#endif // defined( PRVHASH_SIMD_AVX512 )
+
+#if defined( PRVHASH_SIMD_NEON )
+
+/**
+ * An auxiliary function that multiplies 2 unsigned 64-bit values, returning
+ * the lower 64 bits of each product, assembled out of 32x32-bit products.
+ *
+ * @param a Multiplicands.
+ * @param b Multipliers.
+ */
+
+static PRVHASH_INLINE uint64x2_t prvhash_mul64_x2( const uint64x2_t a,
+	const uint64x2_t b )
+{
+	const uint32x2_t al = vmovn_u64( a );
+	const uint32x2_t bl = vmovn_u64( b );
+	const uint32x2_t ah = vshrn_n_u64( a, 32 );
+	const uint32x2_t bh = vshrn_n_u64( b, 32 );
+	const uint32x2_t c = vmla_u32( vmul_u32( al, bh ), ah, bl );
+
+	return( vaddq_u64( vmull_u32( al, bl ), vshll_n_u32( c, 32 )));
+}
+
+/**
+ * Vector (register-level) variant of the "prvhash_core64" function, for 2
+ * independent PRVHASH systems.
+ *
+ * @param[in,out] Seed0 The current "Seed" values.
+ * @param[in,out] lcg0 The current "lcg" values.
+ * @param[in,out] Hash0 Current hash words.
+ * @return Current random values.
+ */
+
+static PRVHASH_INLINE uint64x2_t prvhash_core64_v2( uint64x2_t* const Seed0,
+	uint64x2_t* const lcg0, uint64x2_t* const Hash0 )
+{
+	const uint64x2_t one = vdupq_n_u64( 1 );
+	const uint64x2_t ca = vdupq_n_u64( 0xAAAAAAAAAAAAAAAA );
+	const uint64x2_t c5 = vdupq_n_u64( 0x5555555555555555 );
+
+	uint64x2_t Seed = *Seed0; uint64x2_t lcg = *lcg0;
+	uint64x2_t Hash = *Hash0;
+
+	Seed = prvhash_mul64_x2( Seed, vaddq_u64( vaddq_u64( lcg, lcg ), one ));
+
+	const uint64x2_t rs = vreinterpretq_u64_u32(
+		vrev64q_u32( vreinterpretq_u32_u64( Seed )));
+
+	Hash = vaddq_u64( Hash, vaddq_u64( rs, ca ));
+	lcg = vaddq_u64( lcg, vaddq_u64( Seed, c5 ));
+	Seed = veorq_u64( Seed, Hash );
+	const uint64x2_t out = veorq_u64( lcg, rs );
+
+	*Seed0 = Seed; *lcg0 = lcg; *Hash0 = Hash;
+
+	return( out );
+}
+
+#endif // defined( PRVHASH_SIMD_NEON )
+
+/**
+ * This function runs a single PRVHASH random number generation round for 4
+ * independent PRVHASH systems (lanes) at once. Results are bit-exact with 4
+ * separate "prvhash_core64" function calls. Each array holds lane values in
+ * structure-of-arrays order: element "i" of each array belongs to lane "i".
+ *
+ * @param[in,out] Seed0 The current "Seed" values, 4 elements.
+ * @param[in,out] lcg0 The current "lcg" values, 4 elements.
+ * @param[in,out] Hash0 Current hash words, 4 elements.
+ * @param[out] out Receives the current random values, 4 elements.
+ */
+
+static PRVHASH_INLINE void prvhash_core64_x4( uint64_t* const Seed0,
+	uint64_t* const lcg0, uint64_t* const Hash0, uint64_t* const out )
+{
+#if defined( PRVHASH_SIMD_AVX512 ) || defined( PRVHASH_SIMD_AVX2 )
+
+	__m256i Seed = _mm256_loadu_si256( (const __m256i*) Seed0 );
+	__m256i lcg = _mm256_loadu_si256( (const __m256i*) lcg0 );
+	__m256i Hash = _mm256_loadu_si256( (const __m256i*) Hash0 );
+
+	const __m256i o = prvhash_core64_v4( &Seed, &lcg, &Hash );
+
+	_mm256_storeu_si256( (__m256i*) Seed0, Seed );
+	_mm256_storeu_si256( (__m256i*) lcg0, lcg );
+	_mm256_storeu_si256( (__m256i*) Hash0, Hash );
+	_mm256_storeu_si256( (__m256i*) out, o );
+
+#elif defined( PRVHASH_SIMD_NEON )
+
+	int i;
+
+	for( i = 0; i < 4; i += 2 )
+	{
+		uint64x2_t Seed = vld1q_u64( Seed0 + i );
+		uint64x2_t lcg = vld1q_u64( lcg0 + i );
+		uint64x2_t Hash = vld1q_u64( Hash0 + i );
+
+		const uint64x2_t o = prvhash_core64_v2( &Seed, &lcg, &Hash );
+
+		vst1q_u64( Seed0 + i, Seed );
+		vst1q_u64( lcg0 + i, lcg );
+		vst1q_u64( Hash0 + i, Hash );
+		vst1q_u64( out + i, o );
+	}
+
+#else // defined( PRVHASH_SIMD_NEON )
+
+	out[ 0 ] = prvhash_core64( Seed0, lcg0, Hash0 );
+	out[ 1 ] = prvhash_core64( Seed0 + 1, lcg0 + 1, Hash0 + 1 );
+	out[ 2 ] = prvhash_core64( Seed0 + 2, lcg0 + 2, Hash0 + 2 );
+	out[ 3 ] = prvhash_core64( Seed0 + 3, lcg0 + 3, Hash0 + 3 );
+
+#endif // defined( PRVHASH_SIMD_NEON )
+}
+
+/**
+ * This function runs a single PRVHASH random number generation round for 8
+ * independent PRVHASH systems (lanes) at once. Equivalent to the
+ * "prvhash_core64_x4" function, but for 8 lanes.
+ *
+ * @param[in,out] Seed0 The current "Seed" values, 8 elements.
+ * @param[in,out] lcg0 The current "lcg" values, 8 elements.
+ * @param[in,out] Hash0 Current hash words, 8 elements.
+ * @param[out] out Receives the current random values, 8 elements.
+ */
+
+static PRVHASH_INLINE void prvhash_core64_x8( uint64_t* const Seed0,
+	uint64_t* const lcg0, uint64_t* const Hash0, uint64_t* const out )
+{
+#if defined( PRVHASH_SIMD_AVX512 )
+
+	__m512i Seed = _mm512_loadu_si512( Seed0 );
+	__m512i lcg = _mm512_loadu_si512( lcg0 );
+	__m512i Hash = _mm512_loadu_si512( Hash0 );
+
+	const __m512i o = prvhash_core64_v8( &Seed, &lcg, &Hash );
+
+	_mm512_storeu_si512( Seed0, Seed );
+	_mm512_storeu_si512( lcg0, lcg );
+	_mm512_storeu_si512( Hash0, Hash );
+	_mm512_storeu_si512( out, o );
+
+#else // defined( PRVHASH_SIMD_AVX512 )
+
+	prvhash_core64_x4( Seed0, lcg0, Hash0, out );
+	prvhash_core64_x4( Seed0 + 4, lcg0 + 4, Hash0 + 4, out + 4 );
+
+#endif // defined( PRVHASH_SIMD_AVX512 )
+}
+
+#endif // PRVHASH_SIMD_INCLUDED
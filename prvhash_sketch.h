@@ -0,0 +1,548 @@
+/**
+ * prvhash_sketch.h version 4.3.0
+ *
+ * The inclusion file for probabilistic data structures based on the
+ * "prvhash64_64mk" and "prvhash64_64m" hash functions: blocked Bloom filter,
+ * MinHash sketch, and HyperLogLog cardinality estimator. Each key is
+ * absorbed by the hash function once, with all required hashes produced
+ * from the final state.
+ *
+ * Description is available at https://github.com/avaneev/prvhash
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PRVHASH_SKETCH_INCLUDED
+#define PRVHASH_SKETCH_INCLUDED
+
+#include <math.h>
+#include <stdlib.h>
+#include "prvhash64.h"
+
+#define PRVHASH_BLOOM_BLOCK 64 // Bloom filter's block length, in bytes.
+#define PRVHASH_BLOOM_KMAX 21 // Maximal number of bits set per key.
+#define PRVHASH_MINHASH_PART 64 // MinHash hashes produced per hash call.
+#define PRVHASH_HLL_PMIN 4 // Minimal HyperLogLog precision.
+#define PRVHASH_HLL_PMAX 18 // Maximal HyperLogLog precision.
+
+/**
+ * Blocked Bloom filter's context structure. Each key sets bits within a
+ * single cache-line-sized block, so that a lookup accesses one cache line.
+ */
+
+typedef struct
+{
+	uint64_t* Blocks; ///< Blocks, PRVHASH_BLOOM_BLOCK-byte aligned.
+	void* Mem; ///< Allocated memory block.
+	size_t BlockMask; ///< Block index mask, the number of blocks minus 1.
+	int HashCount; ///< The number of bits set per key.
+	uint64_t UseSeed; ///< Hash seed.
+} PRVHASH_BLOOM_CTX;
+
+/**
+ * Function initializes the Bloom filter. The optimal "HashCount" is
+ * about 0.7 times the number of bits per key (e.g., 7 for 10 bits per key
+ * that produce about 1% false-positive rate).
+ *
+ * @param[out] ctx Context structure.
+ * @param BitCount The minimal number of bits in the filter; rounded up to a
+ * power of 2 number of blocks.
+ * @param HashCount The number of bits set per key, 1 to PRVHASH_BLOOM_KMAX.
+ * @param UseSeed Hash seed, 0 - use the default seed.
+ * @return 0 if the parameters are invalid, or memory could not be allocated.
+ */
+
+static inline int prvhash_bloom_init( PRVHASH_BLOOM_CTX* const ctx,
+	const size_t BitCount, const int HashCount, const uint64_t UseSeed )
+{
+	if( HashCount < 1 || HashCount > PRVHASH_BLOOM_KMAX )
+	{
+		return( 0 );
+	}
+
+	size_t bc = 1;
+
+	while( bc * PRVHASH_BLOOM_BLOCK * 8 < BitCount )
+	{
+		bc <<= 1;
+	}
+
+	const size_t Len = bc * PRVHASH_BLOOM_BLOCK;
+	ctx -> Mem = calloc( Len + PRVHASH_BLOOM_BLOCK, 1 );
+
+	if( ctx -> Mem == 0 )
+	{
+		return( 0 );
+	}
+
+	ctx -> Blocks = (uint64_t*) (( (uintptr_t) ctx -> Mem +
+		PRVHASH_BLOOM_BLOCK - 1 ) & ~(uintptr_t) ( PRVHASH_BLOOM_BLOCK - 1 ));
+
+	ctx -> BlockMask = bc - 1;
+	ctx -> HashCount = HashCount;
+	ctx -> UseSeed = UseSeed;
+
+	return( 1 );
+}
+
+/**
+ * Function releases the memory used by the Bloom filter.
+ *
+ * @param[in,out] ctx Context structure.
+ */
+
+static inline void prvhash_bloom_final( PRVHASH_BLOOM_CTX* const ctx )
+{
+	free( ctx -> Mem );
+	ctx -> Mem = 0;
+	ctx -> Blocks = 0;
+}
+
+/**
+ * Internal function produces the block and the bit mask of a key. The
+ * first hash selects the block, each following hash provides 7 9-bit bit
+ * positions within the block.
+ *
+ * @param ctx Context structure.
+ * @param Msg Key. The alignment of this pointer is unimportant.
+ * @param MsgLen Key's length, in bytes.
+ * @param[out] m Bit mask of the block.
+ * @return Pointer to the block.
+ */
+
+static inline uint64_t* prvhash_bloom_mask( const PRVHASH_BLOOM_CTX* const ctx,
+	const void* const Msg, const size_t MsgLen,
+	uint64_t m[ PRVHASH_BLOOM_BLOCK / 8 ])
+{
+	uint64_t h[ 1 + ( PRVHASH_BLOOM_KMAX + 6 ) / 7 ];
+	const int hc = ctx -> HashCount;
+
+	prvhash64_64mk( Msg, MsgLen, ctx -> UseSeed, h, 1 + ( hc + 6 ) / 7 );
+
+	memset( m, 0, PRVHASH_BLOOM_BLOCK );
+
+	int i;
+
+	for( i = 0; i < hc; i++ )
+	{
+		const int b = (int) ( h[ 1 + i / 7 ] >> ( i % 7 * 9 )) & 511;
+		m[ b >> 6 ] |= (uint64_t) 1 << ( b & 63 );
+	}
+
+	return( ctx -> Blocks + ( (size_t) h[ 0 ] & ctx -> BlockMask ) *
+		( PRVHASH_BLOOM_BLOCK / 8 ));
+}
+
+/**
+ * Function adds a key to the Bloom filter.
+ *
+ * @param[in,out] ctx Context structure.
+ * @param Msg Key. The alignment of this pointer is unimportant.
+ * @param MsgLen Key's length, in bytes.
+ */
+
+static inline void prvhash_bloom_add( PRVHASH_BLOOM_CTX* const ctx,
+	const void* const Msg, const size_t MsgLen )
+{
+	uint64_t m[ PRVHASH_BLOOM_BLOCK / 8 ];
+	uint64_t* const b = prvhash_bloom_mask( ctx, Msg, MsgLen, m );
+	int i;
+
+	for( i = 0; i < PRVHASH_BLOOM_BLOCK / 8; i++ )
+	{
+		b[ i ] |= m[ i ];
+	}
+}
+
+/**
+ * Function checks the presence of a key in the Bloom filter.
+ *
+ * @param ctx Context structure.
+ * @param Msg Key. The alignment of this pointer is unimportant.
+ * @param MsgLen Key's length, in bytes.
+ * @return 1 if the key may be present, 0 if the key is surely absent.
+ */
+
+static inline int prvhash_bloom_test( const PRVHASH_BLOOM_CTX* const ctx,
+	const void* const Msg, const size_t MsgLen )
+{
+	uint64_t m[ PRVHASH_BLOOM_BLOCK / 8 ];
+	const uint64_t* const b = prvhash_bloom_mask( ctx, Msg, MsgLen, m );
+	uint64_t r = 0;
+	int i;
+
+	for( i = 0; i < PRVHASH_BLOOM_BLOCK / 8; i++ )
+	{
+		r |= m[ i ] & ~b[ i ];
+	}
+
+	return( r == 0 );
+}
+
+/**
+ * Function merges the "src" Bloom filter into the "ctx" Bloom filter, which
+ * then represents the union of both key sets.
+ *
+ * @param[in,out] ctx Context structure.
+ * @param src Context structure of the filter to merge.
+ * @return 0 if the filters have different sizes, hash counts or seeds.
+ */
+
+static inline int prvhash_bloom_merge( PRVHASH_BLOOM_CTX* const ctx,
+	const PRVHASH_BLOOM_CTX* const src )
+{
+	if( ctx -> BlockMask != src -> BlockMask ||
+		ctx -> HashCount != src -> HashCount ||
+		ctx -> UseSeed != src -> UseSeed )
+	{
+		return( 0 );
+	}
+
+	const size_t c = ( ctx -> BlockMask + 1 ) * ( PRVHASH_BLOOM_BLOCK / 8 );
+	size_t i;
+
+	for( i = 0; i < c; i++ )
+	{
+		ctx -> Blocks[ i ] |= src -> Blocks[ i ];
+	}
+
+	return( 1 );
+}
+
+/**
+ * MinHash sketch's context structure. For each of "Count" hash functions,
+ * the minimal hash of all added keys is kept.
+ */
+
+typedef struct
+{
+	uint64_t* Mins; ///< Minimal hashes, "Count" elements.
+	size_t Count; ///< The number of hashes in the sketch.
+	uint64_t UseSeed; ///< Hash seed.
+} PRVHASH_MINHASH_CTX;
+
+/**
+ * Function initializes the MinHash sketch of an empty set.
+ *
+ * @param[out] ctx Context structure.
+ * @param Count The number of hashes in the sketch, >= 1; the standard error
+ * of the similarity estimate is about 1 / sqrt( Count ).
+ * @param UseSeed Hash seed, 0 - use the default seed. Only sketches with
+ * equal seeds can be compared.
+ * @return 0 if memory could not be allocated.
+ */
+
+static inline int prvhash_minhash_init( PRVHASH_MINHASH_CTX* const ctx,
+	const size_t Count, const uint64_t UseSeed )
+{
+	ctx -> Mins = (uint64_t*) malloc( Count * sizeof( uint64_t ));
+
+	if( ctx -> Mins == 0 )
+	{
+		return( 0 );
+	}
+
+	memset( ctx -> Mins, 0xFF, Count * sizeof( uint64_t ));
+	ctx -> Count = Count;
+	ctx -> UseSeed = UseSeed;
+
+	return( 1 );
+}
+
+/**
+ * Function releases the memory used by the MinHash sketch.
+ *
+ * @param[in,out] ctx Context structure.
+ */
+
+static inline void prvhash_minhash_final( PRVHASH_MINHASH_CTX* const ctx )
+{
+	free( ctx -> Mins );
+	ctx -> Mins = 0;
+}
+
+/**
+ * Function adds a key to the MinHash sketch. Hashes are produced in portions
+ * of PRVHASH_MINHASH_PART, with each portion's key hashing seeded by the
+ * portion's index: a key is absorbed once per portion.
+ *
+ * @param[in,out] ctx Context structure.
+ * @param Msg Key. The alignment of this pointer is unimportant.
+ * @param MsgLen Key's length, in bytes.
+ */
+
+static inline void prvhash_minhash_add( PRVHASH_MINHASH_CTX* const ctx,
+	const void* const Msg, const size_t MsgLen )
+{
+	uint64_t h[ PRVHASH_MINHASH_PART ];
+	size_t p;
+
+	for( p = 0; p < ctx -> Count; p += PRVHASH_MINHASH_PART )
+	{
+		const size_t c = ( ctx -> Count - p < PRVHASH_MINHASH_PART ?
+			ctx -> Count - p : PRVHASH_MINHASH_PART );
+
+		prvhash64_64mk( Msg, MsgLen, ctx -> UseSeed ^ p, h, c );
+
+		uint64_t* const mins = ctx -> Mins + p;
+		size_t i;
+
+		for( i = 0; i < c; i++ )
+		{
+			mins[ i ] = ( h[ i ] < mins[ i ] ? h[ i ] : mins[ i ]);
+		}
+	}
+}
+
+/**
+ * Function estimates the Jaccard similarity of two sets, using their
+ * MinHash sketches.
+ *
+ * @param ctx Context structure of the first set.
+ * @param ctx2 Context structure of the second set.
+ * @return Similarity estimate, in the [0; 1] range, or -1 if the sketches
+ * have different hash counts or seeds.
+ */
+
+static inline double prvhash_minhash_similarity(
+	const PRVHASH_MINHASH_CTX* const ctx,
+	const PRVHASH_MINHASH_CTX* const ctx2 )
+{
+	if( ctx -> Count != ctx2 -> Count || ctx -> UseSeed != ctx2 -> UseSeed )
+	{
+		return( -1.0 );
+	}
+
+	size_t e = 0;
+	size_t i;
+
+	for( i = 0; i < ctx -> Count; i++ )
+	{
+		e += ( ctx -> Mins[ i ] == ctx2 -> Mins[ i ]);
+	}
+
+	return( (double) e / (double) ctx -> Count );
+}
+
+/**
+ * Function merges the "src" MinHash sketch into the "ctx" MinHash sketch,
+ * which then represents the union of both sets.
+ *
+ * @param[in,out] ctx Context structure.
+ * @param src Context structure of the sketch to merge.
+ * @return 0 if the sketches have different hash counts or seeds.
+ */
+
+static inline int prvhash_minhash_merge( PRVHASH_MINHASH_CTX* const ctx,
+	const PRVHASH_MINHASH_CTX* const src )
+{
+	if( ctx -> Count != src -> Count || ctx -> UseSeed != src -> UseSeed )
+	{
+		return( 0 );
+	}
+
+	size_t i;
+
+	for( i = 0; i < ctx -> Count; i++ )
+	{
+		if( src -> Mins[ i ] < ctx -> Mins[ i ])
+		{
+			ctx -> Mins[ i ] = src -> Mins[ i ];
+		}
+	}
+
+	return( 1 );
+}
+
+/**
+ * HyperLogLog cardinality estimator's context structure.
+ */
+
+typedef struct
+{
+	uint8_t* Regs; ///< Registers, 2^Prec elements.
+	int Prec; ///< Precision, the number of register index bits.
+	uint64_t UseSeed; ///< Hash seed.
+} PRVHASH_HLL_CTX;
+
+/**
+ * Function initializes the HyperLogLog estimator of an empty set.
+ *
+ * @param[out] ctx Context structure.
+ * @param Prec Precision, PRVHASH_HLL_PMIN to PRVHASH_HLL_PMAX: uses 2^Prec
+ * bytes of memory, the standard error of the estimate is about
+ * 1.04 / sqrt( 2^Prec ).
+ * @param UseSeed Hash seed, 0 - use the default seed.
+ * @return 0 if the precision is invalid, or memory could not be allocated.
+ */
+
+static inline int prvhash_hll_init( PRVHASH_HLL_CTX* const ctx,
+	const int Prec, const uint64_t UseSeed )
+{
+	if( Prec < PRVHASH_HLL_PMIN || Prec > PRVHASH_HLL_PMAX )
+	{
+		return( 0 );
+	}
+
+	ctx -> Regs = (uint8_t*) calloc( (size_t) 1 << Prec, 1 );
+
+	if( ctx -> Regs == 0 )
+	{
+		return( 0 );
+	}
+
+	ctx -> Prec = Prec;
+	ctx -> UseSeed = UseSeed;
+
+	return( 1 );
+}
+
+/**
+ * Function releases the memory used by the HyperLogLog estimator.
+ *
+ * @param[in,out] ctx Context structure.
+ */
+
+static inline void prvhash_hll_final( PRVHASH_HLL_CTX* const ctx )
+{
+	free( ctx -> Regs );
+	ctx -> Regs = 0;
+}
+
+/**
+ * Function adds a key to the HyperLogLog estimator. The highest bits of the
+ * key's hash select the register, the remaining bits provide the rank.
+ *
+ * @param[in,out] ctx Context structure.
+ * @param Msg Key. The alignment of this pointer is unimportant.
+ * @param MsgLen Key's length, in bytes.
+ */
+
+static inline void prvhash_hll_add( PRVHASH_HLL_CTX* const ctx,
+	const void* const Msg, const size_t MsgLen )
+{
+	const uint64_t h = prvhash64_64m( Msg, MsgLen, ctx -> UseSeed );
+	const int p = ctx -> Prec;
+	uint64_t w = h << p | (uint64_t) 1 << ( p - 1 );
+	uint8_t r = 1;
+
+	while(( w & 0x8000000000000000 ) == 0 )
+	{
+		w <<= 1;
+		r++;
+	}
+
+	uint8_t* const reg = ctx -> Regs + ( h >> ( 64 - p ));
+
+	if( r > *reg )
+	{
+		*reg = r;
+	}
+}
+
+/**
+ * Function estimates the number of distinct keys added.
+ *
+ * @param ctx Context structure.
+ * @return Cardinality estimate.
+ */
+
+static inline double prvhash_hll_count( const PRVHASH_HLL_CTX* const ctx )
+{
+	const size_t m = (size_t) 1 << ctx -> Prec;
+	double s = 0.0;
+	size_t z = 0;
+	size_t i;
+
+	for( i = 0; i < m; i++ )
+	{
+		s += ldexp( 1.0, -(int) ctx -> Regs[ i ]);
+		z += ( ctx -> Regs[ i ] == 0 );
+	}
+
+	const double dm = (double) m;
+	double a; // Bias correction constant.
+
+	if( m == 16 )
+	{
+		a = 0.673;
+	}
+	else
+	if( m == 32 )
+	{
+		a = 0.697;
+	}
+	else
+	if( m == 64 )
+	{
+		a = 0.709;
+	}
+	else
+	{
+		a = 0.7213 / ( 1.0 + 1.079 / dm );
+	}
+
+	const double e = a * dm * dm / s;
+
+	if( e <= 2.5 * dm && z != 0 )
+	{
+		// Small-range correction: linear counting.
+
+		return( dm * log( dm / (double) z ));
+	}
+
+	return( e );
+}
+
+/**
+ * Function merges the "src" HyperLogLog estimator into the "ctx" estimator,
+ * which then represents the union of both key sets.
+ *
+ * @param[in,out] ctx Context structure.
+ * @param src Context structure of the estimator to merge.
+ * @return 0 if the estimators have different precisions or seeds.
+ */
+
+static inline int prvhash_hll_merge( PRVHASH_HLL_CTX* const ctx,
+	const PRVHASH_HLL_CTX* const src )
+{
+	if( ctx -> Prec != src -> Prec || ctx -> UseSeed != src -> UseSeed )
+	{
+		return( 0 );
+	}
+
+	const size_t m = (size_t) 1 << ctx -> Prec;
+	size_t i;
+
+	for( i = 0; i < m; i++ )
+	{
+		if( src -> Regs[ i ] > ctx -> Regs[ i ])
+		{
+			ctx -> Regs[ i ] = src -> Regs[ i ];
+		}
+	}
+
+	return( 1 );
+}
+
+#endif // PRVHASH_SKETCH_INCLUDED
@@ -0,0 +1,401 @@
+/**
+ * prvhash_thread.h version 4.3.2
+ *
+ * The inclusion file for the minimal portable threading functions used by
+ * the multithreaded PRVHASH functions. On Unix systems, requires linking
+ * with the "pthread" library. Threading can be disabled by defining the
+ * PRVHASH_NO_THREADS macro: in this case, the prvhash_thread_start()
+ * function always fails, and callers perform all work in the calling thread.
+ * The prvhash_thread_run() function performs jobs via a worker pool whose
+ * threads are reused between calls, avoiding thread creation per call.
+ *
+ * Description is available at https://github.com/avaneev/prvhash
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PRVHASH_THREAD_INCLUDED
+#define PRVHASH_THREAD_INCLUDED
+
+#define PRVHASH_THREAD_MAX 64 // Maximal number of threads used by a call.
+
+#if defined( PRVHASH_NO_THREADS )
+
+	#include <stddef.h>
+
+	typedef int PRVHASH_THREAD;
+	#define PRVHASH_THREAD_RET void*
+	#define PRVHASH_THREAD_EXIT return( 0 )
+
+#elif defined( _WIN32 )
+
+	#include <windows.h>
+	#include <stddef.h>
+
+	typedef HANDLE PRVHASH_THREAD;
+	#define PRVHASH_THREAD_RET DWORD WINAPI
+	#define PRVHASH_THREAD_EXIT return( 0 )
+
+#else // defined( _WIN32 )
+
+	#include <pthread.h>
+	#include <stddef.h>
+	#include <unistd.h>
+
+	typedef pthread_t PRVHASH_THREAD;
+	#define PRVHASH_THREAD_RET void*
+	#define PRVHASH_THREAD_EXIT return( 0 )
+
+#endif // defined( _WIN32 )
+
+/**
+ * Thread function type. Thread functions should be declared as
+ * "static PRVHASH_THREAD_RET fn( void* arg )", and should end with the
+ * PRVHASH_THREAD_EXIT statement.
+ */
+
+typedef PRVHASH_THREAD_RET PRVHASH_THREAD_FN( void* );
+
+/**
+ * Function starts a new thread.
+ *
+ * @param[out] th Receives thread's handle.
+ * @param fn Thread function.
+ * @param arg Thread function's argument.
+ * @return 0 if failed; the work should then be performed by the caller.
+ */
+
+static inline int prvhash_thread_start( PRVHASH_THREAD* const th,
+	PRVHASH_THREAD_FN* const fn, void* const arg )
+{
+	#if defined( PRVHASH_NO_THREADS )
+
+		(void) th; (void) fn; (void) arg;
+
+		return( 0 );
+
+	#elif defined( _WIN32 )
+
+		*th = CreateThread( 0, 0, fn, arg, 0, 0 );
+
+		return( *th != 0 );
+
+	#else // defined( _WIN32 )
+
+		return( pthread_create( th, 0, fn, arg ) == 0 );
+
+	#endif // defined( _WIN32 )
+}
+
+/**
+ * Function waits for a thread, started by the prvhash_thread_start()
+ * function, to finish, and releases thread's resources.
+ *
+ * @param th Thread's handle.
+ */
+
+static inline void prvhash_thread_join( PRVHASH_THREAD th )
+{
+	#if defined( PRVHASH_NO_THREADS )
+
+		(void) th;
+
+	#elif defined( _WIN32 )
+
+		WaitForSingleObject( th, INFINITE );
+		CloseHandle( th );
+
+	#else // defined( _WIN32 )
+
+		pthread_join( th, 0 );
+
+	#endif // defined( _WIN32 )
+}
+
+/**
+ * Worker pool, used by the prvhash_thread_run() function. Each compilation
+ * unit that includes this file has its own pool, whose worker threads are
+ * started on demand, and are then reused by subsequent calls. Worker threads
+ * are never terminated: they wait for jobs while idle.
+ */
+
+#if !defined( PRVHASH_NO_THREADS )
+
+#if defined( _WIN32 )
+
+	typedef SRWLOCK PRVHASH_THREAD_LOCK;
+	typedef CONDITION_VARIABLE PRVHASH_THREAD_COND;
+	#define PRVHASH_THREAD_LOCK_INIT SRWLOCK_INIT
+	#define PRVHASH_THREAD_COND_INIT CONDITION_VARIABLE_INIT
+
+#else // defined( _WIN32 )
+
+	typedef pthread_mutex_t PRVHASH_THREAD_LOCK;
+	typedef pthread_cond_t PRVHASH_THREAD_COND;
+	#define PRVHASH_THREAD_LOCK_INIT PTHREAD_MUTEX_INITIALIZER
+	#define PRVHASH_THREAD_COND_INIT PTHREAD_COND_INITIALIZER
+
+#endif // defined( _WIN32 )
+
+typedef struct {
+	PRVHASH_THREAD_LOCK Lock; ///< Protects all other fields.
+	PRVHASH_THREAD_COND WorkCond; ///< Signalled when jobs are posted.
+	PRVHASH_THREAD_COND DoneCond; ///< Signalled when all jobs are done.
+	PRVHASH_THREAD_FN* Fn; ///< Job function.
+	char* Jobs; ///< Job array.
+	size_t JobSize; ///< Size of a job structure, in bytes.
+	int Next; ///< Index of the next job to perform.
+	int Count; ///< The number of jobs in the array.
+	int Pending; ///< The number of jobs that are not yet finished.
+	int Workers; ///< The number of started worker threads.
+	int IsBusy; ///< 1 if the pool is in use by a prvhash_thread_run() call.
+	int IsAtFork; ///< 1 if the fork handler was registered.
+} PRVHASH_THREAD_POOL;
+
+static PRVHASH_THREAD_POOL prvhash_thread_pool = { PRVHASH_THREAD_LOCK_INIT,
+	PRVHASH_THREAD_COND_INIT, PRVHASH_THREAD_COND_INIT, 0, 0, 0, 0, 0, 0, 0,
+	0, 0 };
+
+static inline void prvhash_thread_lock( void )
+{
+	#if defined( _WIN32 )
+		AcquireSRWLockExclusive( &prvhash_thread_pool.Lock );
+	#else // defined( _WIN32 )
+		pthread_mutex_lock( &prvhash_thread_pool.Lock );
+	#endif // defined( _WIN32 )
+}
+
+static inline void prvhash_thread_unlock( void )
+{
+	#if defined( _WIN32 )
+		ReleaseSRWLockExclusive( &prvhash_thread_pool.Lock );
+	#else // defined( _WIN32 )
+		pthread_mutex_unlock( &prvhash_thread_pool.Lock );
+	#endif // defined( _WIN32 )
+}
+
+static inline void prvhash_thread_wait( PRVHASH_THREAD_COND* const c )
+{
+	#if defined( _WIN32 )
+		SleepConditionVariableSRW( c, &prvhash_thread_pool.Lock, INFINITE, 0 );
+	#else // defined( _WIN32 )
+		pthread_cond_wait( c, &prvhash_thread_pool.Lock );
+	#endif // defined( _WIN32 )
+}
+
+static inline void prvhash_thread_wake( PRVHASH_THREAD_COND* const c )
+{
+	#if defined( _WIN32 )
+		WakeAllConditionVariable( c );
+	#else // defined( _WIN32 )
+		pthread_cond_broadcast( c );
+	#endif // defined( _WIN32 )
+}
+
+/**
+ * Function performs the posted jobs until none are left. Should be called
+ * with pool's lock held.
+ */
+
+static inline void prvhash_thread_drain( void )
+{
+	PRVHASH_THREAD_POOL* const p = &prvhash_thread_pool;
+
+	while( p -> Next < p -> Count )
+	{
+		void* const job = p -> Jobs + (size_t) p -> Next * p -> JobSize;
+		PRVHASH_THREAD_FN* const fn = p -> Fn;
+		p -> Next++;
+
+		prvhash_thread_unlock();
+		fn( job );
+		prvhash_thread_lock();
+
+		p -> Pending--;
+
+		if( p -> Pending == 0 )
+		{
+			prvhash_thread_wake( &p -> DoneCond );
+		}
+	}
+}
+
+/**
+ * Worker thread function of the pool.
+ */
+
+static PRVHASH_THREAD_RET prvhash_thread_worker( void* const arg )
+{
+	(void) arg;
+
+	prvhash_thread_lock();
+
+	while( 1 )
+	{
+		prvhash_thread_drain();
+		prvhash_thread_wait( &prvhash_thread_pool.WorkCond );
+	}
+
+	PRVHASH_THREAD_EXIT;
+}
+
+#if !defined( _WIN32 )
+
+/**
+ * Fork handler: worker threads do not exist in the child process, and the
+ * pool is reset to its initial state.
+ */
+
+static void prvhash_thread_atfork_child( void )
+{
+	const PRVHASH_THREAD_POOL p0 = { PRVHASH_THREAD_LOCK_INIT,
+		PRVHASH_THREAD_COND_INIT, PRVHASH_THREAD_COND_INIT, 0, 0, 0, 0, 0, 0,
+		0, 0, 1 };
+
+	prvhash_thread_pool = p0;
+}
+
+#endif // !defined( _WIN32 )
+
+#endif // !defined( PRVHASH_NO_THREADS )
+
+/**
+ * Function performs Count jobs, using the worker pool. Job 0 is performed by
+ * the calling thread, which then helps to perform the remaining jobs, and
+ * waits for all jobs to finish. Missing worker threads are started on the
+ * first use. If the pool is in use by another call (including a call from a
+ * job function), or if threads are unavailable, all jobs are performed by
+ * the calling thread.
+ *
+ * @param fn Job function, declared as a thread function.
+ * @param Jobs Array of Count job structures.
+ * @param JobSize Size of a job structure, in bytes.
+ * @param Count The number of jobs, at most PRVHASH_THREAD_MAX.
+ */
+
+static inline void prvhash_thread_run( PRVHASH_THREAD_FN* const fn,
+	void* const Jobs, const size_t JobSize, const int Count )
+{
+	int i;
+
+	#if !defined( PRVHASH_NO_THREADS )
+
+		PRVHASH_THREAD_POOL* const p = &prvhash_thread_pool;
+
+		prvhash_thread_lock();
+
+		if( !p -> IsBusy && Count > 1 )
+		{
+			p -> IsBusy = 1;
+
+			#if !defined( _WIN32 )
+				if( !p -> IsAtFork )
+				{
+					p -> IsAtFork = ( pthread_atfork( 0, 0,
+						prvhash_thread_atfork_child ) == 0 );
+				}
+			#endif // !defined( _WIN32 )
+
+			while( p -> Workers < Count - 1 )
+			{
+				PRVHASH_THREAD th;
+
+				if( !prvhash_thread_start( &th, prvhash_thread_worker, 0 ))
+				{
+					break;
+				}
+
+				#if defined( _WIN32 )
+					CloseHandle( th );
+				#else // defined( _WIN32 )
+					pthread_detach( th );
+				#endif // defined( _WIN32 )
+
+				p -> Workers++;
+			}
+
+			p -> Fn = fn;
+			p -> Jobs = (char*) Jobs;
+			p -> JobSize = JobSize;
+			p -> Next = 0;
+			p -> Count = Count;
+			p -> Pending = Count;
+
+			prvhash_thread_wake( &p -> WorkCond );
+			prvhash_thread_drain();
+
+			while( p -> Pending > 0 )
+			{
+				prvhash_thread_wait( &p -> DoneCond );
+			}
+
+			p -> Count = 0;
+			p -> Next = 0;
+			p -> IsBusy = 0;
+
+			prvhash_thread_unlock();
+			return;
+		}
+
+		prvhash_thread_unlock();
+
+	#endif // !defined( PRVHASH_NO_THREADS )
+
+	for( i = 0; i < Count; i++ )
+	{
+		fn( (char*) Jobs + (size_t) i * JobSize );
+	}
+}
+
+/**
+ * @return The number of online processor cores, at least 1, and at most
+ * PRVHASH_THREAD_MAX.
+ */
+
+static inline int prvhash_thread_count( void )
+{
+	long c = 1;
+
+	#if defined( PRVHASH_NO_THREADS )
+
+	#elif defined( _WIN32 )
+
+		SYSTEM_INFO si;
+		GetSystemInfo( &si );
+		c = (long) si.dwNumberOfProcessors;
+
+	#elif defined( _SC_NPROCESSORS_ONLN )
+
+		c = sysconf( _SC_NPROCESSORS_ONLN );
+
+	#endif // defined( _SC_NPROCESSORS_ONLN )
+
+	if( c < 1 )
+	{
+		c = 1;
+	}
+
+	return( (int) ( c > PRVHASH_THREAD_MAX ? PRVHASH_THREAD_MAX : c ));
+}
+
+#endif // PRVHASH_THREAD_INCLUDED
@@ -0,0 +1,216 @@
+/**
+ * prvhashsum.c version 4.3.0
+ *
+ * Program calculates and prints "prvhash64s" hashes of the specified files,
+ * in the style of the "sha256sum" utility. Files are hashed in parallel.
+ *
+ * Usage: prvhashsum [-l bits] [-j threads] file ...
+ *
+ * -l bits Hash length, in bits: 64, 128, 256, 512 or 1024; default 256.
+ * -j threads The number of threads to use; by default equals the number of
+ * processor cores.
+ *
+ * Hash values are printed as hexadecimal bytes, in the order they are stored
+ * in memory, equal to the test vectors listed in the README. On Unix
+ * systems, should be compiled with the "-pthread" option.
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "prvhash64s_file.h"
+#include "prvhash_thread.h"
+
+#define HASH_MAX 128 // Maximal hash length, in bytes.
+
+typedef struct
+{
+	char** Files; // File names.
+	uint8_t* Hashes; // Hashes of all files, HashLen bytes per file.
+	int* Results; // prvhash64s_file() results for all files.
+	int FileCount; // The number of files.
+	size_t HashLen; // Hash length, in bytes.
+	int Thread; // Thread's index.
+	int ThreadCount; // The number of threads in use.
+} JOB;
+
+/**
+ * Thread function that hashes every ThreadCount-th file, beginning with the
+ * file at the Thread index.
+ */
+
+static PRVHASH_THREAD_RET hash_files( void* const arg )
+{
+	const JOB* const job = (const JOB*) arg;
+	int i;
+
+	for( i = job -> Thread; i < job -> FileCount; i += job -> ThreadCount )
+	{
+		job -> Results[ i ] = prvhash64s_file( job -> Files[ i ],
+			job -> Hashes + (size_t) i * job -> HashLen, job -> HashLen );
+	}
+
+	PRVHASH_THREAD_EXIT;
+}
+
+static void usage( void )
+{
+	fprintf( stderr, "Usage: prvhashsum [-l bits] [-j threads] file ...\n" );
+}
+
+int main( int argc, char** argv )
+{
+	size_t HashLen = 32;
+	int ThreadCount = prvhash_thread_count();
+	int i = 1;
+
+	while( i < argc && argv[ i ][ 0 ] == '-' && argv[ i ][ 1 ] != 0 )
+	{
+		if( strcmp( argv[ i ], "--" ) == 0 )
+		{
+			i++;
+			break;
+		}
+
+		if( i + 1 >= argc )
+		{
+			usage();
+			return( 2 );
+		}
+
+		const int v = atoi( argv[ i + 1 ]);
+
+		if( strcmp( argv[ i ], "-l" ) == 0 )
+		{
+			if( v < 64 || v > HASH_MAX * 8 || ( v & ( v - 1 )) != 0 )
+			{
+				fprintf( stderr, "prvhashsum: unsupported hash length\n" );
+				return( 2 );
+			}
+
+			HashLen = (size_t) v / 8;
+		}
+		else
+		if( strcmp( argv[ i ], "-j" ) == 0 && v > 0 )
+		{
+			ThreadCount = ( v > PRVHASH_THREAD_MAX ? PRVHASH_THREAD_MAX : v );
+		}
+		else
+		{
+			usage();
+			return( 2 );
+		}
+
+		i += 2;
+	}
+
+	const int FileCount = argc - i;
+
+	if( FileCount <= 0 )
+	{
+		usage();
+		return( 2 );
+	}
+
+	if( ThreadCount > FileCount )
+	{
+		ThreadCount = FileCount;
+	}
+
+	uint8_t* const Hashes = (uint8_t*) malloc( (size_t) FileCount * HashLen );
+	int* const Results = (int*) malloc( (size_t) FileCount * sizeof( int ));
+
+	if( Hashes == 0 || Results == 0 )
+	{
+		fprintf( stderr, "prvhashsum: out of memory\n" );
+		return( 2 );
+	}
+
+	JOB jobs[ PRVHASH_THREAD_MAX ];
+	PRVHASH_THREAD th[ PRVHASH_THREAD_MAX ];
+	int started[ PRVHASH_THREAD_MAX ];
+	int k;
+
+	for( k = 0; k < ThreadCount; k++ )
+	{
+		jobs[ k ].Files = argv + i;
+		jobs[ k ].Hashes = Hashes;
+		jobs[ k ].Results = Results;
+		jobs[ k ].FileCount = FileCount;
+		jobs[ k ].HashLen = HashLen;
+		jobs[ k ].Thread = k;
+		jobs[ k ].ThreadCount = ThreadCount;
+
+		// Job 0 is performed by the calling thread.
+
+		started[ k ] = ( k > 0 &&
+			prvhash_thread_start( &th[ k ], hash_files, &jobs[ k ]));
+	}
+
+	for( k = 0; k < ThreadCount; k++ )
+	{
+		if( !started[ k ])
+		{
+			hash_files( &jobs[ k ]);
+		}
+	}
+
+	for( k = 1; k < ThreadCount; k++ )
+	{
+		if( started[ k ])
+		{
+			prvhash_thread_join( th[ k ]);
+		}
+	}
+
+	int ret = 0;
+
+	for( k = 0; k < FileCount; k++ )
+	{
+		if( !Results[ k ])
+		{
+			fprintf( stderr, "prvhashsum: %s: cannot read file\n",
+				argv[ i + k ]);
+
+			ret = 1;
+			continue;
+		}
+
+		const uint8_t* const h = Hashes + (size_t) k * HashLen;
+		size_t j;
+
+		for( j = 0; j < HashLen; j++ )
+		{
+			printf( "%02x", h[ j ]);
+		}
+
+		printf( "  %s\n", argv[ i + k ]);
+	}
+
+	free( Hashes );
+	free( Results );
+
+	return( ret );
+}
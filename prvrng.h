@@ -5,6 +5,14 @@
  * This is mostly an example PRNG that demonstrates use of infrequent external
  * entropy injections in the course of random number generation.
  *
+ * Entropy is obtained from the operating system's random number source -
+ * getrandom(), getentropy(), BCryptGenRandom(), or "/dev/urandom" where
+ * neither is available, or the system call is unavailable at run time (older
+ * kernels, sandboxes) - in PRVRNG_ENT_BUF-byte portions, which are then
+ * consumed gradually. If a refill fails, the generator continues without
+ * entropy injections until a later refill succeeds; such failures are
+ * counted in the EntErrors field.
+ *
  * Description is available at https://github.com/avaneev/prvhash
  *
  * License
@@ -30,7 +38,7 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
-//$ lib "win*|AdvAPI32"
+//$ lib "win*|Bcrypt"
 
 #ifndef PRVRNG_INCLUDED
 #define PRVRNG_INCLUDED
@@ -38,10 +46,36 @@
 #include <stdio.h>
 
 #if defined( _WIN32 )
+
 	#include <windows.h>
-	#include <wincrypt.h>
+	#include <bcrypt.h>
+
 #else // defined( _WIN32 )
+
 	#define PRVRNG_UNIX 1
+
+	#include <errno.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+
+	#if defined( __linux__ ) && defined( __GLIBC__ ) && \
+		( __GLIBC__ > 2 || ( __GLIBC__ == 2 && __GLIBC_MINOR__ >= 25 ))
+
+		#include <sys/random.h>
+
+		#define PRVRNG_GETRANDOM 1
+
+	#elif defined( __APPLE__ ) || defined( __OpenBSD__ ) || \
+		defined( __FreeBSD__ )
+
+		#if defined( __APPLE__ )
+			#include <sys/random.h>
+		#endif // defined( __APPLE__ )
+
+		#define PRVRNG_GETENTROPY 1
+
+	#endif // defined( __APPLE__ )
+
 #endif // defined( _WIN32 )
 
 #include "prvhash_core.h"
@@ -52,13 +86,12 @@
 
 #define PRVRNG_FUSE_COUNT 2 // PRNG fusing.
 #define PRVRNG_HASH_COUNT 16 // Hashwords in a hasharray.
+#define PRVRNG_ENT_BUF 4096 // Entropy buffer's length, in bytes.
 
 typedef struct
 {
 	#if defined( PRVRNG_UNIX )
-		FILE* f; ///< /dev/random file.
-	#else // defined( PRVRNG_UNIX )
-		HCRYPTPROV prov; ///< Crypt provider (for Windows).
+		int fd; ///< /dev/urandom file descriptor, -1 if not in use.
 	#endif // defined( PRVRNG_UNIX )
 
 	uint64_t Seed[ PRVRNG_FUSE_COUNT ]; ///< Current Seed values.
@@ -68,79 +101,197 @@ typedef struct
 	int EntCtr; ///< Bytes remaining before entropy is injected.
 	size_t OutLeft; ///< Bytes left in LastOut.
 	uint64_t LastOut; ///< Previously generated output.
+	size_t EntPos; ///< Position of unused entropy within EntBuf.
+	size_t EntErrors; ///< The number of failed entropy buffer refills.
+	uint8_t EntBuf[ PRVRNG_ENT_BUF ]; ///< Pre-fetched entropy bytes.
 } PRVRNG_CTX;
 
 /**
- * Internal function returns a "true" entropy value. This is simulated
- * by obtaining a byte from "/dev/random" or Windows' CryptGenRandom().
+ * Internal function fills the entropy buffer from the system's random
+ * number source, and resets the entropy position. If the getrandom() or
+ * getentropy() system call is unavailable, "/dev/urandom" is opened, and
+ * is used afterwards.
  *
  * @param ctx Pointer to the context structure.
- * @param c The number of bytes to return, 1 to 8.
+ * @return 0 if failed; the entropy position remains unchanged in this case,
+ * so that the buffer's previous contents are not reused.
  */
 
-static inline uint64_t prvrng_get_entropy( PRVRNG_CTX* const ctx,
-	const size_t c )
+static inline int prvrng_fill_entropy( PRVRNG_CTX* const ctx )
 {
-	uint8_t val[ 8 ];
-	memset( val, 0, sizeof( val ));
+	int res = 1;
 
 	#if defined( PRVRNG_UNIX )
 
-		fread( val, 1, c, ctx -> f );
+		size_t o = 0;
+
+		while( o < PRVRNG_ENT_BUF )
+		{
+			ssize_t l;
+
+			if( ctx -> fd >= 0 )
+			{
+				l = read( ctx -> fd, ctx -> EntBuf + o, PRVRNG_ENT_BUF - o );
+			}
+			else
+			{
+				#if defined( PRVRNG_GETRANDOM )
+
+					l = getrandom( ctx -> EntBuf + o, PRVRNG_ENT_BUF - o, 0 );
+
+				#elif defined( PRVRNG_GETENTROPY )
+
+					// getentropy() returns at most 256 bytes per call.
+
+					l = ( getentropy( ctx -> EntBuf + o, 256 ) == 0 ?
+						256 : -1 );
+
+				#else // defined( PRVRNG_GETENTROPY )
+
+					l = -1;
+					errno = ENOSYS;
+
+				#endif // defined( PRVRNG_GETENTROPY )
+
+				if( l < 0 && ( errno == ENOSYS || errno == EPERM ))
+				{
+					ctx -> fd = open( "/dev/urandom", O_RDONLY );
+
+					if( ctx -> fd >= 0 )
+					{
+						continue;
+					}
+				}
+			}
+
+			if( l > 0 )
+			{
+				o += (size_t) l;
+			}
+			else
+			if( l == 0 || errno != EINTR )
+			{
+				res = 0;
+				break;
+			}
+		}
 
 	#else // defined( PRVRNG_UNIX )
 
-		CryptGenRandom( ctx -> prov, (DWORD) c, val );
+		res = BCRYPT_SUCCESS( BCryptGenRandom( 0, ctx -> EntBuf,
+			(ULONG) PRVRNG_ENT_BUF, BCRYPT_USE_SYSTEM_PREFERRED_RNG ));
 
 	#endif // defined( PRVRNG_UNIX )
 
-	return( prvhash_lu64ec( val ));
+	if( res )
+	{
+		ctx -> EntPos = 0;
+	}
+	else
+	{
+		ctx -> EntErrors++;
+	}
+
+	return( res );
 }
 
 /**
- * Function generates the next random 8-bit number.
+ * Internal function returns a "true" entropy value. This is simulated
+ * by obtaining bytes from the system's random number source, via the
+ * entropy buffer.
  *
  * @param ctx Pointer to the context structure.
+ * @param c The number of bytes to return, 1 to 8.
+ * @param[out] v The resulting entropy value.
+ * @return 0 if the entropy buffer cannot be refilled; "v" is zeroed in this
+ * case.
  */
 
-static inline uint8_t prvrng_gen64p2( PRVRNG_CTX* const ctx )
+static inline int prvrng_get_entropy( PRVRNG_CTX* const ctx, const size_t c,
+	uint64_t* const v )
 {
-	if( ctx -> OutLeft == 0 )
+	if( PRVRNG_ENT_BUF - ctx -> EntPos < c && !prvrng_fill_entropy( ctx ))
+	{
+		*v = 0;
+		return( 0 );
+	}
+
+	uint8_t val[ 8 ];
+	memset( val, 0, sizeof( val ));
+	memcpy( val, ctx -> EntBuf + ctx -> EntPos, c );
+	ctx -> EntPos += c;
+
+	*v = prvhash_lu64ec( val );
+
+	return( 1 );
+}
+
+/**
+ * Internal function generates the next 64-bit output, by XORing the outputs
+ * of two PRVHASH rounds, and injects entropy when it is due. The output's
+ * bytes, from lowest to highest, form the generator's byte stream.
+ *
+ * @param ctx Pointer to the context structure.
+ */
+
+static inline uint64_t prvrng_round( PRVRNG_CTX* const ctx )
+{
+	if( ctx -> EntCtr == 0 )
 	{
-		if( ctx -> EntCtr == 0 )
+		uint64_t v;
+
+		if( prvrng_get_entropy( ctx, 2, &v ))
 		{
-			const uint16_t v = (uint16_t) prvrng_get_entropy( ctx, 2 );
-			ctx -> EntCtr = ( v & 0xFF ) + 1;
+			ctx -> EntCtr = (int) ( v & 0xFF ) + 1;
 
 			const uint64_t ent = ( v >> 8 ) + 1;
 			ctx -> Seed[ 0 ] ^= ent;
 			ctx -> lcg[ 0 ] ^= ent;
 		}
+		else
+		{
+			ctx -> EntCtr = 256; // Retry the refill later.
+		}
+	}
 
-		uint64_t rv = 0;
-		int k;
+	uint64_t rv = 0;
+	int k;
 
-		for( k = 0; k < 2; k++ )
-		{
-			uint64_t* const Hash = ctx -> Hash + ctx -> HashPos;
-			int i;
+	for( k = 0; k < 2; k++ )
+	{
+		uint64_t* const Hash = ctx -> Hash + ctx -> HashPos;
+		int i;
 
-			for( i = 0; i < PRVRNG_FUSE_COUNT - 1; i++ )
-			{
-				prvhash_core64( &ctx -> Seed[ i ], &ctx -> lcg[ i ], Hash );
-			}
+		for( i = 0; i < PRVRNG_FUSE_COUNT - 1; i++ )
+		{
+			prvhash_core64( &ctx -> Seed[ i ], &ctx -> lcg[ i ], Hash );
+		}
 
-			rv ^= prvhash_core64( &ctx -> Seed[ i ], &ctx -> lcg[ i ], Hash );
+		rv ^= prvhash_core64( &ctx -> Seed[ i ], &ctx -> lcg[ i ], Hash );
 
-			if( ++ctx -> HashPos == PRVRNG_HASH_COUNT )
-			{
-				ctx -> HashPos = 0;
-			}
+		if( ++ctx -> HashPos == PRVRNG_HASH_COUNT )
+		{
+			ctx -> HashPos = 0;
 		}
+	}
+
+	ctx -> EntCtr--;
+
+	return( rv );
+}
+
+/**
+ * Function generates the next random 8-bit number.
+ *
+ * @param ctx Pointer to the context structure.
+ */
 
-		ctx -> LastOut = rv;
+static inline uint8_t prvrng_gen64p2( PRVRNG_CTX* const ctx )
+{
+	if( ctx -> OutLeft == 0 )
+	{
+		ctx -> LastOut = prvrng_round( ctx );
 		ctx -> OutLeft = sizeof( ctx -> LastOut );
-		ctx -> EntCtr--;
 	}
 
 	const uint8_t r = (uint8_t) ctx -> LastOut;
@@ -151,45 +302,128 @@ static inline uint8_t prvrng_gen64p2( PRVRNG_CTX* const ctx )
 }
 
 /**
- * Function initalizes the entropy PRNG context. It also seeds the generator
- * with the initial entropy.
+ * Function generates the next random 64-bit number. The number is composed
+ * of the next 8 bytes of the prvrng_gen64p2() function's byte stream, with
+ * the first byte in the lowest bits, so that both functions can be used
+ * interchangeably.
  *
  * @param ctx Pointer to the context structure.
- * @return 0 if failed.
  */
 
-static inline int prvrng_init64p2( PRVRNG_CTX* const ctx )
+static inline uint64_t prvrng_gen64( PRVRNG_CTX* const ctx )
 {
-	#if defined( PRVRNG_UNIX )
+	const uint64_t rv = prvrng_round( ctx );
 
-		ctx -> f = fopen( "/dev/random", "rb" );
+	if( ctx -> OutLeft == 0 )
+	{
+		return( rv );
+	}
 
-		if( ctx -> f == 0 )
-		{
-			return( 0 );
-		}
+	const int s = (int) ctx -> OutLeft * 8;
+	const uint64_t r = ctx -> LastOut | rv << s;
+	ctx -> LastOut = rv >> ( 64 - s );
 
-	#else // defined( PRVRNG_UNIX )
+	return( r );
+}
 
-		if( !CryptAcquireContext( &ctx -> prov, 0, 0, PROV_RSA_FULL,
-			CRYPT_VERIFYCONTEXT ))
+/**
+ * Function fills the buffer with random bytes. The bytes are equal to
+ * the prvrng_gen64p2() function's byte stream, but are produced as whole
+ * 64-bit words, which is a lot faster.
+ *
+ * @param ctx Pointer to the context structure.
+ * @param[out] Buf Output buffer. The address alignment is unimportant.
+ * @param Len Buffer's length, in bytes.
+ */
+
+static inline void prvrng_fill( PRVRNG_CTX* const ctx, void* const Buf,
+	size_t Len )
+{
+	uint8_t* op = (uint8_t*) Buf;
+
+	while( ctx -> OutLeft > 0 && Len > 0 )
+	{
+		*op = prvrng_gen64p2( ctx );
+		op++;
+		Len--;
+	}
+
+	while( Len >= sizeof( uint64_t ))
+	{
+		const uint64_t v = PRVHASH_EC64( prvrng_round( ctx ));
+		memcpy( op, &v, sizeof( v ));
+		op += sizeof( v );
+		Len -= sizeof( v );
+	}
+
+	while( Len > 0 )
+	{
+		*op = prvrng_gen64p2( ctx );
+		op++;
+		Len--;
+	}
+}
+
+/**
+ * Function deinitializes the PRNG, for 32-bit hash.
+ *
+ * @param ctx Pointer to the context structure.
+ */
+
+static inline void prvrng_final64p2( PRVRNG_CTX* const ctx )
+{
+	#if defined( PRVRNG_UNIX )
+
+		if( ctx -> fd >= 0 )
 		{
-			return( 0 );
+			close( ctx -> fd );
+			ctx -> fd = -1;
 		}
 
 	#endif // defined( PRVRNG_UNIX )
 
+	// Unused entropy bytes are not left in memory.
+
+	memset( ctx -> EntBuf, 0, sizeof( ctx -> EntBuf ));
+	ctx -> EntPos = PRVRNG_ENT_BUF;
+}
+
+/**
+ * Function initalizes the entropy PRNG context. It also seeds the generator
+ * with the initial entropy.
+ *
+ * @param ctx Pointer to the context structure.
+ * @return 0 if failed.
+ */
+
+static inline int prvrng_init64p2( PRVRNG_CTX* const ctx )
+{
+	#if defined( PRVRNG_UNIX )
+		ctx -> fd = -1; // Opened by prvrng_fill_entropy(), if needed.
+	#endif // defined( PRVRNG_UNIX )
+
+	ctx -> EntPos = PRVRNG_ENT_BUF;
+	ctx -> EntErrors = 0;
+
+	if( !prvrng_fill_entropy( ctx ))
+	{
+		prvrng_final64p2( ctx );
+		return( 0 );
+	}
+
 	int i;
 
+	// The filled buffer is enough for the initial entropy.
+
 	for( i = 0; i < PRVRNG_FUSE_COUNT; i++ )
 	{
-		ctx -> Seed[ i ] = prvrng_get_entropy( ctx, sizeof( uint64_t ));
-		ctx -> lcg[ i ] = prvrng_get_entropy( ctx, sizeof( uint64_t ));
+		prvrng_get_entropy( ctx, sizeof( uint64_t ), &ctx -> Seed[ i ]);
+		prvrng_get_entropy( ctx, sizeof( uint64_t ), &ctx -> lcg[ i ]);
 	}
 
 	for( i = 0; i < PRVRNG_HASH_COUNT; i++ )
 	{
-		ctx -> Hash[ i ] = prvrng_get_entropy( ctx, sizeof( uint64_t ));
+		prvrng_get_entropy( ctx, sizeof( uint64_t ), &ctx -> Hash[ i ]);
 	}
 
 	ctx -> HashPos = 0;
@@ -213,25 +447,6 @@ static inline int prvrng_init64p2( PRVRNG_CTX* const ctx )
 	return( 1 );
 }
 
-/**
- * Function deinitializes the PRNG, for 32-bit hash.
- *
- * @param ctx Pointer to the context structure.
- */
-
-static inline void prvrng_final64p2( PRVRNG_CTX* const ctx )
-{
-	#if defined( PRVRNG_UNIX )
-
-		fclose( ctx -> f );
-
-	#else // defined( PRVRNG_UNIX )
-
-		CryptReleaseContext( ctx -> prov, 0 );
-
-	#endif // defined( PRVRNG_UNIX )
-}
-
 /**
  * A test function for "prvrng", 32-bit hash-based. Prints 16 random bytes.
  */
@@ -0,0 +1,540 @@
+/**
+ * prvrng_tls.h version 4.3.2
+ *
+ * The inclusion file for the multithreaded front end of the "prvrng" entropy
+ * pseudo-random number generator. Each thread uses its own cache-line-aligned
+ * thread-local PRNG state, while true entropy is obtained from a single
+ * process-wide "prvrng" generator, which owns the only entropy buffer.
+ * The process-wide generator is accessed only when a thread's state is
+ * seeded, and when an entropy injection is due, under a short spin-lock:
+ * other outputs are produced without any synchronization. System calls that
+ * refill the entropy buffer are made outside the spin-lock, by the thread
+ * that requests entropy: a background refill thread and a lock-free entropy
+ * hand-out are not used, as the spin-lock is taken only once in 1 to 256
+ * outputs of each thread, for a few nanoseconds.
+ *
+ * On Unix systems, a child process created via fork() reseeds the
+ * process-wide generator, and the thread-local state, on the next use, so
+ * that the child's outputs are not equal to the parent's outputs. This
+ * requires the pthread_atfork() function, and on some systems the "-pthread"
+ * compiler option.
+ *
+ * The process-wide generator is defined in the "prvrng_tls.c" source file,
+ * which should be compiled and linked with the program. Thread-local states
+ * are separate in each compilation unit that includes this file, but all of
+ * them are seeded from the same process-wide generator.
+ *
+ * Description is available at https://github.com/avaneev/prvhash
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PRVRNG_TLS_INCLUDED
+#define PRVRNG_TLS_INCLUDED
+
+#include <string.h>
+#include "prvrng.h"
+
+#if defined( PRVRNG_UNIX )
+	#include <pthread.h>
+#endif // defined( PRVRNG_UNIX )
+
+#define PRVRNG_TLS_LINE 64 // Assumed cache line's length, in bytes.
+
+// Thread-local storage, alignment and spin-lock primitives.
+
+#if defined( _MSC_VER )
+
+	#define PRVRNG_TLS_VAR __declspec( thread )
+	#define PRVRNG_TLS_ALIGN __declspec( align( PRVRNG_TLS_LINE ))
+	#define PRVRNG_TLS_XCHG( p, v ) InterlockedExchange( p, v )
+	#define PRVRNG_TLS_LOAD( p ) ( *( p ))
+	#define PRVRNG_TLS_STORE( p, v ) InterlockedExchange( p, v )
+	#define PRVRNG_TLS_PAUSE YieldProcessor()
+
+	typedef volatile LONG PRVRNG_TLS_LOCK;
+
+#else // defined( _MSC_VER )
+
+	#if defined( __cplusplus ) && __cplusplus >= 201103L
+
+		#define PRVRNG_TLS_VAR thread_local
+
+	#elif defined( PRVHASH_GCC_BUILTINS )
+
+		#define PRVRNG_TLS_VAR __thread
+
+	#else // defined( PRVHASH_GCC_BUILTINS )
+
+		#define PRVRNG_TLS_VAR _Thread_local
+
+	#endif // defined( PRVHASH_GCC_BUILTINS )
+
+	#define PRVRNG_TLS_ALIGN __attribute__(( aligned( PRVRNG_TLS_LINE )))
+	#define PRVRNG_TLS_XCHG( p, v ) __atomic_exchange_n( p, v, __ATOMIC_ACQUIRE )
+	#define PRVRNG_TLS_LOAD( p ) __atomic_load_n( p, __ATOMIC_RELAXED )
+	#define PRVRNG_TLS_STORE( p, v ) __atomic_store_n( p, v, __ATOMIC_RELEASE )
+
+	#if defined( __i386__ ) || defined( __x86_64__ )
+		#define PRVRNG_TLS_PAUSE __builtin_ia32_pause()
+	#else // defined( __i386__ ) || defined( __x86_64__ )
+		#define PRVRNG_TLS_PAUSE
+	#endif // defined( __i386__ ) || defined( __x86_64__ )
+
+	typedef long PRVRNG_TLS_LOCK;
+
+#endif // defined( _MSC_VER )
+
+/**
+ * Thread-local PRNG state structure. Its alignment and size are multiples of
+ * the cache line's length, to avoid false sharing.
+ */
+
+typedef struct PRVRNG_TLS_ALIGN
+{
+	uint64_t Seed[ PRVRNG_FUSE_COUNT ]; ///< Current Seed values.
+	uint64_t lcg[ PRVRNG_FUSE_COUNT ]; ///< Current lcg values.
+	uint64_t Hash[ PRVRNG_HASH_COUNT ]; ///< Current hash values.
+	size_t HashPos; ///< Position within the Hash array.
+	int EntCtr; ///< Outputs remaining before entropy is injected.
+	int IsInit; ///< 1 if the state was seeded.
+	int ForkGen; ///< The pool's ForkGen value at the time of seeding.
+} PRVRNG_TLS_CTX;
+
+/**
+ * Process-wide entropy pool structure.
+ */
+
+typedef struct PRVRNG_TLS_ALIGN
+{
+	PRVRNG_TLS_LOCK Lock; ///< Spin-lock, 1 if the pool is in use.
+	int IsInit; ///< 1 if the "ctx" was initialized.
+	int IsAtFork; ///< 1 if the fork() handler was registered.
+	int ForkGen; ///< Incremented in a child process after fork().
+	PRVRNG_CTX ctx; ///< Process-wide entropy PRNG.
+} PRVRNG_TLS_POOL;
+
+#if defined( __cplusplus )
+extern "C" {
+#endif // defined( __cplusplus )
+
+extern PRVRNG_TLS_POOL prvrng_tls_pool; ///< Defined in "prvrng_tls.c".
+
+#if defined( __cplusplus )
+}
+#endif // defined( __cplusplus )
+
+static PRVRNG_TLS_VAR PRVRNG_TLS_CTX prvrng_tls_ctx;
+
+/**
+ * Internal function acquires the entropy pool's spin-lock.
+ */
+
+static inline void prvrng_tls_lock( void )
+{
+	while( PRVRNG_TLS_XCHG( &prvrng_tls_pool.Lock, 1 ) != 0 )
+	{
+		while( PRVRNG_TLS_LOAD( &prvrng_tls_pool.Lock ) != 0 )
+		{
+			PRVRNG_TLS_PAUSE;
+		}
+	}
+}
+
+/**
+ * Internal function releases the entropy pool's spin-lock.
+ */
+
+static inline void prvrng_tls_unlock( void )
+{
+	PRVRNG_TLS_STORE( &prvrng_tls_pool.Lock, 0 );
+}
+
+#if defined( PRVRNG_UNIX )
+
+/**
+ * Internal fork() handler, called in the child process, which has a single
+ * thread. Releases the spin-lock that could be held by another thread of
+ * the parent process, and deinitializes the duplicated process-wide
+ * generator, so that it is reinitialized with new entropy on next use.
+ * Thread-local states are reseeded due to the changed ForkGen value.
+ */
+
+static void prvrng_tls_atfork_child( void )
+{
+	prvrng_tls_pool.Lock = 0;
+
+	if( prvrng_tls_pool.IsInit )
+	{
+		prvrng_final64p2( &prvrng_tls_pool.ctx );
+		prvrng_tls_pool.IsInit = 0;
+	}
+
+	prvrng_tls_pool.ForkGen++;
+}
+
+#endif // defined( PRVRNG_UNIX )
+
+/**
+ * Internal function initializes the process-wide generator, if it is not
+ * initialized. Should be called under the spin-lock.
+ *
+ * @return 0 if failed.
+ */
+
+static inline int prvrng_tls_pool_init( void )
+{
+	if( !prvrng_tls_pool.IsInit )
+	{
+		#if defined( PRVRNG_UNIX )
+
+			if( !prvrng_tls_pool.IsAtFork )
+			{
+				prvrng_tls_pool.IsAtFork =
+					( pthread_atfork( 0, 0, prvrng_tls_atfork_child ) == 0 );
+			}
+
+		#endif // defined( PRVRNG_UNIX )
+
+		prvrng_tls_pool.IsInit = prvrng_init64p2( &prvrng_tls_pool.ctx );
+	}
+
+	return( prvrng_tls_pool.IsInit );
+}
+
+/**
+ * Internal function obtains entropy bytes from the process-wide generator,
+ * initializing it on first use. If the generator's entropy buffer may run
+ * out while the bytes are produced, the buffer is refilled beforehand, with
+ * the spin-lock released during the system call.
+ *
+ * @param[out] p Output buffer.
+ * @param c The number of bytes to obtain, <= 256.
+ * @return 0 if the process-wide generator cannot be initialized.
+ */
+
+static inline int prvrng_tls_pool_get( uint8_t* const p, const size_t c )
+{
+	PRVRNG_CTX* const pc = &prvrng_tls_pool.ctx;
+
+	// Each round of the generator consumes at most 2 entropy bytes.
+
+	const size_t need = ( c / 8 + 2 ) * 2;
+	size_t i;
+
+	prvrng_tls_lock();
+
+	if( !prvrng_tls_pool_init() )
+	{
+		prvrng_tls_unlock();
+		return( 0 );
+	}
+
+	if( PRVRNG_ENT_BUF - pc -> EntPos < need )
+	{
+		PRVRNG_CTX tmp;
+
+		#if defined( PRVRNG_UNIX )
+			tmp.fd = pc -> fd;
+		#endif // defined( PRVRNG_UNIX )
+
+		tmp.EntErrors = 0;
+
+		prvrng_tls_unlock();
+		const int res = prvrng_fill_entropy( &tmp );
+		prvrng_tls_lock();
+
+		#if defined( PRVRNG_UNIX )
+
+			// The fill could have opened "/dev/urandom", as a fallback.
+
+			if( tmp.fd != pc -> fd )
+			{
+				if( pc -> fd < 0 )
+				{
+					pc -> fd = tmp.fd;
+				}
+				else
+				{
+					close( tmp.fd );
+				}
+			}
+
+		#endif // defined( PRVRNG_UNIX )
+
+		// Another thread could have refilled the buffer meanwhile.
+
+		if( PRVRNG_ENT_BUF - pc -> EntPos < need )
+		{
+			if( res )
+			{
+				memcpy( pc -> EntBuf, tmp.EntBuf, PRVRNG_ENT_BUF );
+				pc -> EntPos = 0;
+			}
+			else
+			{
+				// Postpone the entropy injection, so that the generator
+				// does not retry the refill under the spin-lock.
+
+				pc -> EntErrors++;
+				pc -> EntCtr = 256;
+			}
+		}
+
+		memset( tmp.EntBuf, 0, PRVRNG_ENT_BUF );
+	}
+
+	for( i = 0; i < c; i++ )
+	{
+		p[ i ] = prvrng_gen64p2( pc );
+	}
+
+	prvrng_tls_unlock();
+
+	return( 1 );
+}
+
+/**
+ * Function initializes the process-wide entropy pool. The pool is also
+ * initialized on first use, and so this function can be used to check the
+ * availability of the system's random number source in advance. Repeated
+ * calls are ignored.
+ *
+ * @return 0 if failed.
+ */
+
+static inline int prvrng_tls_init( void )
+{
+	prvrng_tls_lock();
+	const int res = prvrng_tls_pool_init();
+	prvrng_tls_unlock();
+
+	return( res );
+}
+
+/**
+ * Function deinitializes the process-wide entropy pool. Should be called
+ * after all threads stopped using the prvrng_tls functions. If these
+ * functions are used afterwards, the pool is initialized again.
+ */
+
+static inline void prvrng_tls_final( void )
+{
+	prvrng_tls_lock();
+
+	if( prvrng_tls_pool.IsInit )
+	{
+		prvrng_final64p2( &prvrng_tls_pool.ctx );
+		prvrng_tls_pool.IsInit = 0;
+	}
+
+	prvrng_tls_unlock();
+}
+
+/**
+ * Internal function seeds the calling thread's PRNG state, like the
+ * prvrng_init64p2() function does, but with entropy obtained from the
+ * process-wide generator.
+ *
+ * @param ctx Pointer to the thread-local state.
+ * @return 0 if the process-wide generator is unavailable; the state remains
+ * unseeded in this case.
+ */
+
+static inline int prvrng_tls_seed( PRVRNG_TLS_CTX* const ctx )
+{
+	uint8_t ent[ ( PRVRNG_FUSE_COUNT * 2 + PRVRNG_HASH_COUNT ) * 8 ];
+	const uint8_t* e = ent;
+	int i;
+
+	if( !prvrng_tls_pool_get( ent, sizeof( ent )))
+	{
+		return( 0 );
+	}
+
+	for( i = 0; i < PRVRNG_FUSE_COUNT; i++ )
+	{
+		ctx -> Seed[ i ] = prvhash_lu64ec( e );
+		ctx -> lcg[ i ] = prvhash_lu64ec( e + 8 );
+		e += 16;
+	}
+
+	for( i = 0; i < PRVRNG_HASH_COUNT; i++ )
+	{
+		ctx -> Hash[ i ] = prvhash_lu64ec( e );
+		e += 8;
+	}
+
+	ctx -> HashPos = 0;
+	ctx -> EntCtr = 0;
+	ctx -> IsInit = 1;
+	ctx -> ForkGen = prvrng_tls_pool.ForkGen;
+
+	int k;
+
+	for( k = 0; k < PRVRNG_HASH_COUNT; k++ )
+	{
+		uint64_t* const Hash = ctx -> Hash + k;
+
+		for( i = 0; i < PRVRNG_FUSE_COUNT; i++ )
+		{
+			prvhash_core64( &ctx -> Seed[ i ], &ctx -> lcg[ i ], Hash );
+		}
+	}
+
+	memset( ent, 0, sizeof( ent ));
+
+	return( 1 );
+}
+
+/**
+ * Internal function generates the next 64-bit output of the thread-local
+ * state, like the prvrng_gen64p2() function does: two PRVHASH rounds are
+ * XORed, and entropy injections are performed at random intervals of 1 to
+ * 256 outputs. The state should be seeded.
+ *
+ * @param ctx Pointer to the thread-local state.
+ */
+
+static inline uint64_t prvrng_tls_gen( PRVRNG_TLS_CTX* const ctx )
+{
+	if( ctx -> EntCtr == 0 )
+	{
+		uint8_t v[ 2 ];
+
+		if( prvrng_tls_pool_get( v, 2 ))
+		{
+			ctx -> EntCtr = v[ 0 ] + 1;
+
+			const uint64_t ent = (uint64_t) v[ 1 ] + 1;
+			ctx -> Seed[ 0 ] ^= ent;
+			ctx -> lcg[ 0 ] ^= ent;
+		}
+		else
+		{
+			ctx -> EntCtr = 256; // The pool became unavailable, retry later.
+		}
+	}
+
+	uint64_t rv = 0;
+	int k;
+
+	for( k = 0; k < 2; k++ )
+	{
+		uint64_t* const Hash = ctx -> Hash + ctx -> HashPos;
+		int i;
+
+		for( i = 0; i < PRVRNG_FUSE_COUNT - 1; i++ )
+		{
+			prvhash_core64( &ctx -> Seed[ i ], &ctx -> lcg[ i ], Hash );
+		}
+
+		rv ^= prvhash_core64( &ctx -> Seed[ i ], &ctx -> lcg[ i ], Hash );
+
+		if( ++ctx -> HashPos == PRVRNG_HASH_COUNT )
+		{
+			ctx -> HashPos = 0;
+		}
+	}
+
+	ctx -> EntCtr--;
+
+	return( rv );
+}
+
+/**
+ * Internal function checks that the thread-local state was seeded, in the
+ * current process.
+ *
+ * @param ctx Pointer to the thread-local state.
+ */
+
+static inline int prvrng_tls_ready( const PRVRNG_TLS_CTX* const ctx )
+{
+	return( ctx -> IsInit && ctx -> ForkGen == prvrng_tls_pool.ForkGen );
+}
+
+/**
+ * Function returns the next random 64-bit number, produced by the calling
+ * thread's PRNG state which is seeded on first use, and after fork(). Can
+ * be called by any number of threads concurrently.
+ *
+ * @return Random number; 0 if the state cannot be seeded, because the
+ * system's random number source is unavailable (the prvrng_tls_init() or
+ * prvrng_tls_fill() function can be used to detect this condition).
+ */
+
+static inline uint64_t prvrng_tls_get64( void )
+{
+	PRVRNG_TLS_CTX* const ctx = &prvrng_tls_ctx;
+
+	if( !prvrng_tls_ready( ctx ) && !prvrng_tls_seed( ctx ))
+	{
+		return( 0 );
+	}
+
+	return( prvrng_tls_gen( ctx ));
+}
+
+/**
+ * Function fills the buffer with random bytes, produced by the calling
+ * thread's PRNG state which is seeded on first use, and after fork(). Can
+ * be called by any number of threads concurrently. 64-bit outputs are stored
+ * in the little-endian byte order, like the prvrng_gen64p2() function returns
+ * them.
+ *
+ * @param[out] Buf Output buffer. The address alignment is unimportant.
+ * @param Len Buffer's length, in bytes.
+ * @return 0 if the state cannot be seeded, because the system's random
+ * number source is unavailable; the buffer is zeroed in this case.
+ */
+
+static inline int prvrng_tls_fill( void* const Buf, size_t Len )
+{
+	PRVRNG_TLS_CTX* const ctx = &prvrng_tls_ctx;
+	uint8_t* op = (uint8_t*) Buf;
+
+	if( !prvrng_tls_ready( ctx ) && !prvrng_tls_seed( ctx ))
+	{
+		memset( Buf, 0, Len );
+		return( 0 );
+	}
+
+	while( Len >= sizeof( uint64_t ))
+	{
+		const uint64_t v = PRVHASH_EC64( prvrng_tls_gen( ctx ));
+		memcpy( op, &v, sizeof( v ));
+		op += sizeof( v );
+		Len -= sizeof( v );
+	}
+
+	if( Len > 0 )
+	{
+		const uint64_t v = PRVHASH_EC64( prvrng_tls_gen( ctx ));
+		memcpy( op, &v, Len );
+	}
+
+	return( 1 );
+}
+
+#endif // PRVRNG_TLS_INCLUDED
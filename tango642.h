@@ -32,7 +32,7 @@
 #ifndef TANGO642_INCLUDED
 #define TANGO642_INCLUDED
 
-#include "prvhash_core.h"
+#include "prvhash_simd.h"
 
 #define TANGO642_T uint64_t // PRVHASH state variable type.
 #define TANGO642_S sizeof( TANGO642_T ) // State variable type's size.
@@ -47,6 +47,9 @@
 #define TANGO642_SH( v1, v2, v3, v4, v5 ) \
 	{ TANGO642_T t = v1; v1 = v2; v2 = v3; v3 = v4; v4 = v5; v5 = t; }
 	// 5-value shift macro.
+#define TANGO642_BLK_ITERS 8 // PRNG iterations per vector XOR block.
+#define TANGO642_BLK_SIZE ( TANGO642_S * TANGO642_PAR * TANGO642_BLK_ITERS )
+	// XOR block's size, in bytes.
 
 /**
  * tango642 context structure, can be placed on stack. On systems where this
@@ -68,48 +71,107 @@ typedef struct
 } TANGO642_CTX;
 
 /**
- * This function initializes the "tango642" structure. After the session, the
- * tango642_final() function should be called.
- *
- * Note that this function can be also used as a "conditioning" function for
- * the specified "key" and "iv" values, to minimize overhead if "iv" values
- * are pre-generated and cached. In this case, the initialized context
- * structure can be stored as a whole, and used as a substitute for key+iv
- * pair.
+ * An auxiliary function that initializes the firewalling PRNG from the
+ * zero state, using the keyed PRNG's output, and stores the state of both
+ * PRNGs in the context structure.
  *
- * When "keylen+ivlen" is larger than 1104 bits, there can be theoretical
- * "key+iv" collisions: such collisions should not pose a security threat
- * (negligible probability), but may be perceived as "non-ideal". However,
- * when the "keylen" is 1024 bits long it still allows "iv" to be 64 bits
- * long "safely".
+ * @param[in,out] ctx Pointer to the context structure, with initialized
+ * keyed PRNG's hash values.
+ * @param Seed Keyed PRNG's Seed value.
+ * @param lcg Keyed PRNG's lcg value.
+ */
+
+static inline void tango642_init_fw( TANGO642_CTX* const ctx,
+	TANGO642_T Seed, TANGO642_T lcg )
+{
+	// Initialize firewalling PRNG, making sure each lcg and hash value
+	// receives keyed entropy thrice, or otherwise a further keyed entropy
+	// input helps to reveal the key. Such entropy accumulation is the essence
+	// of "firewalling".
+
+	uint8_t* const ha = (uint8_t*) ctx -> Hash;
+	TANGO642_T SeedF1 = 0;
+	TANGO642_T SeedF2 = 0;
+	TANGO642_T SeedF3 = 0;
+	TANGO642_T SeedF4 = 0;
+	TANGO642_T lcgF1 = 0;
+	TANGO642_T lcgF2 = 0;
+	TANGO642_T lcgF3 = 0;
+	TANGO642_T lcgF4 = 0;
+	TANGO642_T HashF1 = 0;
+	TANGO642_T HashF2 = 0;
+	TANGO642_T HashF3 = 0;
+	TANGO642_T HashF4 = 0;
+	TANGO642_T HashF5 = 0;
+
+	size_t hp = TANGO642_S;
+	size_t i;
+
+	for( i = 0; i < ( TANGO642_PAR + 1 ) * 3; i++ )
+	{
+		// Input from keyed PRNG extends PRNG period's exponent of the output.
+
+		SeedF4 ^= TANGO642_FN( &Seed, &lcg, (TANGO642_T*) ( ha + hp ));
+		hp = ( hp + TANGO642_S ) & TANGO642_HASH_MASK;
+
+		// Parallel arrangement PRNG for efficiency.
+
+		TANGO642_FN( &SeedF1, &lcgF1, &HashF1 );
+		TANGO642_FN( &SeedF2, &lcgF2, &HashF2 );
+		TANGO642_FN( &SeedF3, &lcgF3, &HashF3 );
+		TANGO642_FN( &SeedF4, &lcgF4, &HashF4 );
+
+		TANGO642_SH( HashF1, HashF2, HashF3, HashF4, HashF5 );
+	}
+
+	ctx -> Seed = Seed;
+	ctx -> lcg = lcg;
+	ctx -> SeedF[ 0 ] = SeedF1;
+	ctx -> SeedF[ 1 ] = SeedF2;
+	ctx -> SeedF[ 2 ] = SeedF3;
+	ctx -> SeedF[ 3 ] = SeedF4;
+	ctx -> lcgF[ 0 ] = lcgF1;
+	ctx -> lcgF[ 1 ] = lcgF2;
+	ctx -> lcgF[ 2 ] = lcgF3;
+	ctx -> lcgF[ 3 ] = lcgF4;
+	ctx -> HashF[ 0 ] = HashF1;
+	ctx -> HashF[ 1 ] = HashF2;
+	ctx -> HashF[ 2 ] = HashF3;
+	ctx -> HashF[ 3 ] = HashF4;
+	ctx -> HashF[ 4 ] = HashF5;
+	ctx -> HashPos = hp;
+	ctx -> RndPos = TANGO642_PAR;
+}
+
+/**
+ * This function initializes the keyed template of the "tango642" structure,
+ * using only the "key". The template can be then used by the
+ * tango642_init_iv() and tango642_init_ivn() functions, to initialize the
+ * XOR sessions for various "iv" values, without repeating key's
+ * conditioning. The template itself cannot be used for XOR, and it should be
+ * finalized by the tango642_final() function after the use.
  *
- * @param[out] ctx Pointer to the context structure. Should be aligned to
+ * @param[out] kt Pointer to the template structure. Should be aligned to
  * 8 bytes.
  * @param key0 Uniformly-random key buffer, address alignment is unimportant.
  * @param keylen Length of "key", in bytes; should be >= 16, in increments of
  * 8. Should not exceed 128 bytes.
- * @param iv0 Uniformly-random "unsecure" initialization vector (nonce),
- * address alignment is unimportant. Can be 0 if "ivlen" is also 0.
- * @param ivlen Length of "iv", in bytes, in increments of 8; can be zero.
- * Should not exceed 64 bytes.
  */
 
-static inline void tango642_init( TANGO642_CTX* const ctx,
-	const void* const key0, const size_t keylen, const void* const iv0,
-	const size_t ivlen )
+static inline void tango642_init_key( TANGO642_CTX* const kt,
+	const void* const key0, const size_t keylen )
 {
 	const uint8_t* const key = (const uint8_t*) key0;
-	const uint8_t* const iv = (const uint8_t*) iv0;
 
-	memset( ctx, 0, sizeof( TANGO642_CTX ));
+	memset( kt, 0, sizeof( TANGO642_CTX ));
 
 	// Load a key.
 
 	TANGO642_T Seed = TANGO642_LUEC( key );
 	TANGO642_T lcg = 0;
 
-	uint8_t* const ha = (uint8_t*) ctx -> Hash;
-	uint8_t* ha2 = ha - TANGO642_S;
+	uint8_t* const ha = (uint8_t*) kt -> Hash;
+	uint8_t* const ha2 = ha - TANGO642_S;
 	size_t i;
 
 	for( i = TANGO642_S; i < keylen; i += TANGO642_S )
@@ -124,9 +186,65 @@ static inline void tango642_init( TANGO642_CTX* const ctx,
 		TANGO642_FN( &Seed, &lcg, (TANGO642_T*) ha );
 	}
 
+	kt -> Seed = Seed;
+	kt -> lcg = lcg;
+}
+
+/**
+ * An auxiliary function that copies the keyed template into the context
+ * structure, and clears the leftover random output.
+ *
+ * @param[out] ctx Pointer to the context structure.
+ * @param kt Pointer to the keyed template, can be equal to "ctx".
+ */
+
+static inline void tango642_init_kt( TANGO642_CTX* const ctx,
+	const TANGO642_CTX* const kt )
+{
+	if( ctx != kt )
+	{
+		memcpy( ctx -> Hash, kt -> Hash, TANGO642_HASH_SIZE );
+	}
+
+	memset( ctx -> SeedF, 0, sizeof( ctx -> SeedF ));
+	memset( ctx -> lcgF, 0, sizeof( ctx -> lcgF ));
+	memset( ctx -> HashF, 0, sizeof( ctx -> HashF ));
+	memset( ctx -> RndBytes, 0, sizeof( ctx -> RndBytes ));
+	memset( ctx -> RndLeft, 0, sizeof( ctx -> RndLeft ));
+}
+
+/**
+ * This function initializes the "tango642" structure using the keyed
+ * template, produced by the tango642_init_key() function, and "iv". The
+ * resulting structure is equal to the one produced by the tango642_init()
+ * function for the same "key" and "iv" values. After the session, the
+ * tango642_final() function should be called.
+ *
+ * @param[out] ctx Pointer to the context structure. Should be aligned to
+ * 8 bytes.
+ * @param kt Pointer to the keyed template, can be equal to "ctx" (the
+ * template is consumed in this case).
+ * @param iv0 Uniformly-random "unsecure" initialization vector (nonce),
+ * address alignment is unimportant. Can be 0 if "ivlen" is also 0.
+ * @param ivlen Length of "iv", in bytes, in increments of 8; can be zero.
+ * Should not exceed 64 bytes.
+ */
+
+static inline void tango642_init_iv( TANGO642_CTX* const ctx,
+	const TANGO642_CTX* const kt, const void* const iv0, const size_t ivlen )
+{
+	const uint8_t* const iv = (const uint8_t*) iv0;
+
+	TANGO642_T Seed = kt -> Seed;
+	TANGO642_T lcg = kt -> lcg;
+
+	tango642_init_kt( ctx, kt );
+
 	// Input "iv" as external unstructured entropy.
 
-	ha2 = ha;
+	uint8_t* const ha = (uint8_t*) ctx -> Hash;
+	uint8_t* ha2 = ha;
+	size_t i;
 
 	for( i = 0; i < ivlen; i += TANGO642_S )
 	{
@@ -156,61 +274,268 @@ static inline void tango642_init( TANGO642_CTX* const ctx,
 
 	TANGO642_FN( &Seed, &lcg, (TANGO642_T*) ha );
 
-	// Initialize firewalling PRNG, making sure each lcg and hash value
-	// receives keyed entropy thrice, or otherwise a further keyed entropy
-	// input helps to reveal the key. Such entropy accumulation is the essence
-	// of "firewalling".
+	tango642_init_fw( ctx, Seed, lcg );
+}
 
-	TANGO642_T SeedF1 = ctx -> SeedF[ 0 ];
-	TANGO642_T SeedF2 = ctx -> SeedF[ 1 ];
-	TANGO642_T SeedF3 = ctx -> SeedF[ 2 ];
-	TANGO642_T SeedF4 = ctx -> SeedF[ 3 ];
-	TANGO642_T lcgF1 = ctx -> lcgF[ 0 ];
-	TANGO642_T lcgF2 = ctx -> lcgF[ 1 ];
-	TANGO642_T lcgF3 = ctx -> lcgF[ 2 ];
-	TANGO642_T lcgF4 = ctx -> lcgF[ 3 ];
-	TANGO642_T HashF1 = ctx -> HashF[ 0 ];
-	TANGO642_T HashF2 = ctx -> HashF[ 1 ];
-	TANGO642_T HashF3 = ctx -> HashF[ 2 ];
-	TANGO642_T HashF4 = ctx -> HashF[ 3 ];
-	TANGO642_T HashF5 = ctx -> HashF[ 4 ];
+/**
+ * Batched variant of the tango642_init_iv() function that initializes
+ * several "tango642" structures for the same key and various "iv" values of
+ * equal length. Keyed PRNGs of 4 structures are processed in an interleaved
+ * manner, for a higher throughput. The resulting structures are equal to the
+ * ones produced by the tango642_init_iv() function.
+ *
+ * @param[out] ctxs Context structures, "count" items.
+ * @param kt Pointer to the keyed template, should not be included in
+ * "ctxs".
+ * @param ivs Pointers to "iv" values, "count" items.
+ * @param ivlen Length of each "iv", in bytes, in increments of 8; can be
+ * zero. Should not exceed 64 bytes.
+ * @param count The number of structures to initialize.
+ */
 
-	size_t hp = TANGO642_S;
+static inline void tango642_init_ivn( TANGO642_CTX* ctxs,
+	const TANGO642_CTX* const kt, const void* const* ivs, const size_t ivlen,
+	size_t count )
+{
+	#define TANGO642_FN4( o ) \
+		TANGO642_FN( &Seed1, &lcg1, (TANGO642_T*) ( ha1 + ( o ))); \
+		TANGO642_FN( &Seed2, &lcg2, (TANGO642_T*) ( ha2 + ( o ))); \
+		TANGO642_FN( &Seed3, &lcg3, (TANGO642_T*) ( ha3 + ( o ))); \
+		TANGO642_FN( &Seed4, &lcg4, (TANGO642_T*) ( ha4 + ( o )));
 
-	for( i = 0; i < ( TANGO642_PAR + 1 ) * 3; i++ )
+	while( count >= 4 )
 	{
-		// Input from keyed PRNG extends PRNG period's exponent of the output.
+		const uint8_t* const iv1 = (const uint8_t*) ivs[ 0 ];
+		const uint8_t* const iv2 = (const uint8_t*) ivs[ 1 ];
+		const uint8_t* const iv3 = (const uint8_t*) ivs[ 2 ];
+		const uint8_t* const iv4 = (const uint8_t*) ivs[ 3 ];
+		uint8_t* const ha1 = (uint8_t*) ctxs[ 0 ].Hash;
+		uint8_t* const ha2 = (uint8_t*) ctxs[ 1 ].Hash;
+		uint8_t* const ha3 = (uint8_t*) ctxs[ 2 ].Hash;
+		uint8_t* const ha4 = (uint8_t*) ctxs[ 3 ].Hash;
+		TANGO642_T Seed1 = kt -> Seed;
+		TANGO642_T Seed2 = Seed1;
+		TANGO642_T Seed3 = Seed1;
+		TANGO642_T Seed4 = Seed1;
+		TANGO642_T lcg1 = kt -> lcg;
+		TANGO642_T lcg2 = lcg1;
+		TANGO642_T lcg3 = lcg1;
+		TANGO642_T lcg4 = lcg1;
+		size_t i;
+
+		tango642_init_kt( ctxs, kt );
+		tango642_init_kt( ctxs + 1, kt );
+		tango642_init_kt( ctxs + 2, kt );
+		tango642_init_kt( ctxs + 3, kt );
+
+		for( i = 0; i < ivlen; i += TANGO642_S )
+		{
+			TANGO642_FN4( i * 2 );
+
+			const TANGO642_T v1 = TANGO642_LUEC( iv1 + i );
+			const TANGO642_T v2 = TANGO642_LUEC( iv2 + i );
+			const TANGO642_T v3 = TANGO642_LUEC( iv3 + i );
+			const TANGO642_T v4 = TANGO642_LUEC( iv4 + i );
+
+			Seed1 ^= v1;
+			lcg1 ^= v1;
+			Seed2 ^= v2;
+			lcg2 ^= v2;
+			Seed3 ^= v3;
+			lcg3 ^= v3;
+			Seed4 ^= v4;
+			lcg4 ^= v4;
+
+			TANGO642_FN4( i * 2 + TANGO642_S );
+		}
 
-		SeedF4 ^= TANGO642_FN( &Seed, &lcg, (TANGO642_T*) ( ha + hp ));
-		hp = ( hp + TANGO642_S ) & TANGO642_HASH_MASK;
+		for( i = i * 2; i < TANGO642_HASH_SIZE; i += TANGO642_S )
+		{
+			TANGO642_FN4( i );
+		}
 
-		// Parallel arrangement PRNG for efficiency.
+		for( i = 0; i < TANGO642_HASH_SIZE; i += TANGO642_S )
+		{
+			TANGO642_FN4( i );
+		}
 
-		TANGO642_FN( &SeedF1, &lcgF1, &HashF1 );
-		TANGO642_FN( &SeedF2, &lcgF2, &HashF2 );
-		TANGO642_FN( &SeedF3, &lcgF3, &HashF3 );
-		TANGO642_FN( &SeedF4, &lcgF4, &HashF4 );
+		TANGO642_FN4( 0 );
 
-		TANGO642_SH( HashF1, HashF2, HashF3, HashF4, HashF5 );
+		tango642_init_fw( ctxs, Seed1, lcg1 );
+		tango642_init_fw( ctxs + 1, Seed2, lcg2 );
+		tango642_init_fw( ctxs + 2, Seed3, lcg3 );
+		tango642_init_fw( ctxs + 3, Seed4, lcg4 );
+
+		ctxs += 4;
+		ivs += 4;
+		count -= 4;
 	}
 
-	ctx -> Seed = Seed;
-	ctx -> lcg = lcg;
-	ctx -> SeedF[ 0 ] = SeedF1;
-	ctx -> SeedF[ 1 ] = SeedF2;
-	ctx -> SeedF[ 2 ] = SeedF3;
-	ctx -> SeedF[ 3 ] = SeedF4;
-	ctx -> lcgF[ 0 ] = lcgF1;
-	ctx -> lcgF[ 1 ] = lcgF2;
-	ctx -> lcgF[ 2 ] = lcgF3;
-	ctx -> lcgF[ 3 ] = lcgF4;
-	ctx -> HashF[ 0 ] = HashF1;
-	ctx -> HashF[ 1 ] = HashF2;
-	ctx -> HashF[ 2 ] = HashF3;
-	ctx -> HashF[ 3 ] = HashF4;
-	ctx -> HashF[ 4 ] = HashF5;
-	ctx -> HashPos = hp;
-	ctx -> RndPos = TANGO642_PAR;
+	#undef TANGO642_FN4
+
+	while( count != 0 )
+	{
+		tango642_init_iv( ctxs, kt, *ivs, ivlen );
+
+		ctxs++;
+		ivs++;
+		count--;
+	}
+}
+
+/**
+ * This function initializes the "tango642" structure. After the session, the
+ * tango642_final() function should be called. This function is equivalent
+ * to the tango642_init_key() function followed by the tango642_init_iv()
+ * function.
+ *
+ * Note that this function can be also used as a "conditioning" function for
+ * the specified "key" and "iv" values, to minimize overhead if "iv" values
+ * are pre-generated and cached. In this case, the initialized context
+ * structure can be stored as a whole, and used as a substitute for key+iv
+ * pair.
+ *
+ * When "keylen+ivlen" is larger than 1104 bits, there can be theoretical
+ * "key+iv" collisions: such collisions should not pose a security threat
+ * (negligible probability), but may be perceived as "non-ideal". However,
+ * when the "keylen" is 1024 bits long it still allows "iv" to be 64 bits
+ * long "safely".
+ *
+ * @param[out] ctx Pointer to the context structure. Should be aligned to
+ * 8 bytes.
+ * @param key0 Uniformly-random key buffer, address alignment is unimportant.
+ * @param keylen Length of "key", in bytes; should be >= 16, in increments of
+ * 8. Should not exceed 128 bytes.
+ * @param iv0 Uniformly-random "unsecure" initialization vector (nonce),
+ * address alignment is unimportant. Can be 0 if "ivlen" is also 0.
+ * @param ivlen Length of "iv", in bytes, in increments of 8; can be zero.
+ * Should not exceed 64 bytes.
+ */
+
+static inline void tango642_init( TANGO642_CTX* const ctx,
+	const void* const key0, const size_t keylen, const void* const iv0,
+	const size_t ivlen )
+{
+	tango642_init_key( ctx, key0, keylen );
+	tango642_init_iv( ctx, ctx, iv0, ivlen );
+}
+
+#if defined( PRVHASH_SIMD )
+
+/**
+ * An auxiliary function that XORs the specified message with the keystream
+ * block, using vector instructions.
+ *
+ * @param[in,out] msg Message, address alignment is unimportant.
+ * @param ks Keystream block, in endianness-corrected form.
+ * @param l Length of the message, in bytes; in increments of
+ * TANGO642_S * TANGO642_PAR, should not exceed TANGO642_BLK_SIZE.
+ */
+
+static PRVHASH_INLINE void tango642_xor_blk( uint8_t* msg,
+	const TANGO642_T* ks, size_t l )
+{
+	#if defined( PRVHASH_SIMD_AVX512 )
+
+		while( l >= 64 )
+		{
+			_mm512_storeu_si512( (__m512i*) msg, _mm512_xor_si512(
+				_mm512_loadu_si512( (const __m512i*) msg ),
+				_mm512_loadu_si512( (const __m512i*) ks )));
+
+			msg += 64;
+			ks += 8;
+			l -= 64;
+		}
+
+		if( l != 0 )
+		{
+			_mm256_storeu_si256( (__m256i*) msg, _mm256_xor_si256(
+				_mm256_loadu_si256( (const __m256i*) msg ),
+				_mm256_loadu_si256( (const __m256i*) ks )));
+		}
+
+	#elif defined( PRVHASH_SIMD_AVX2 )
+
+		while( l != 0 )
+		{
+			_mm256_storeu_si256( (__m256i*) msg, _mm256_xor_si256(
+				_mm256_loadu_si256( (const __m256i*) msg ),
+				_mm256_loadu_si256( (const __m256i*) ks )));
+
+			msg += 32;
+			ks += 4;
+			l -= 32;
+		}
+
+	#elif defined( PRVHASH_SIMD_NEON )
+
+		while( l != 0 )
+		{
+			vst1q_u8( msg, veorq_u8( vld1q_u8( msg ),
+				vld1q_u8( (const uint8_t*) ks )));
+
+			vst1q_u8( msg + 16, veorq_u8( vld1q_u8( msg + 16 ),
+				vld1q_u8( (const uint8_t*) ( ks + 2 ))));
+
+			msg += 32;
+			ks += 4;
+			l -= 32;
+		}
+
+	#endif // defined( PRVHASH_SIMD_NEON )
+}
+
+#endif // defined( PRVHASH_SIMD )
+
+/**
+ * An auxiliary function that XORs the specified message with the leading
+ * bytes of the leftover random output value.
+ *
+ * @param[in,out] msg Message, address alignment is unimportant.
+ * @param RndBytes Random output value, leading bytes reside in lower bits.
+ * @param l Length of the message, in bytes, 1 to TANGO642_S.
+ */
+
+static PRVHASH_INLINE void tango642_xor_part( uint8_t* msg,
+	TANGO642_T RndBytes, const size_t l )
+{
+	if( l == TANGO642_S )
+	{
+		TANGO642_T mx;
+		memcpy( &mx, msg, TANGO642_S );
+
+		mx ^= TANGO642_EC( RndBytes );
+		memcpy( msg, &mx, TANGO642_S );
+
+		return;
+	}
+
+	if( l & 4 )
+	{
+		uint32_t mx;
+		memcpy( &mx, msg, 4 );
+
+		mx ^= PRVHASH_EC32( (uint32_t) RndBytes );
+		memcpy( msg, &mx, 4 );
+
+		RndBytes >>= 32;
+		msg += 4;
+	}
+
+	if( l & 2 )
+	{
+		msg[ 0 ] ^= (uint8_t) RndBytes;
+		msg[ 1 ] ^= (uint8_t) ( RndBytes >> 8 );
+
+		RndBytes >>= 16;
+		msg += 2;
+	}
+
+	if( l & 1 )
+	{
+		*msg ^= (uint8_t) RndBytes;
+	}
 }
 
 /**
@@ -251,6 +576,46 @@ static inline void tango642_xor( TANGO642_CTX* const ctx, void* const msg0,
 			uint8_t* const ha = (uint8_t*) ctx -> Hash;
 			size_t hp = ctx -> HashPos;
 
+		#if defined( PRVHASH_SIMD )
+
+			while( msglen >= TANGO642_BLK_SIZE )
+			{
+				// Generate keystream for several iterations, and XOR it with
+				// the message using vector instructions.
+
+				TANGO642_T ks[ TANGO642_PAR * TANGO642_BLK_ITERS ];
+				size_t j;
+
+				for( j = 0; j < TANGO642_PAR * TANGO642_BLK_ITERS;
+					j += TANGO642_PAR )
+				{
+					SeedF4 ^= TANGO642_FN( &Seed, &lcg,
+						(TANGO642_T*) ( ha + hp ));
+
+					hp = ( hp + TANGO642_S ) & TANGO642_HASH_MASK;
+
+					ks[ j ] = TANGO642_EC( TANGO642_FN( &SeedF1, &lcgF1,
+						&HashF1 ));
+
+					ks[ j + 1 ] = TANGO642_EC( TANGO642_FN( &SeedF2, &lcgF2,
+						&HashF2 ));
+
+					ks[ j + 2 ] = TANGO642_EC( TANGO642_FN( &SeedF3, &lcgF3,
+						&HashF3 ));
+
+					ks[ j + 3 ] = TANGO642_EC( TANGO642_FN( &SeedF4, &lcgF4,
+						&HashF4 ));
+
+					TANGO642_SH( HashF1, HashF2, HashF3, HashF4, HashF5 );
+				}
+
+				tango642_xor_blk( msg, ks, TANGO642_BLK_SIZE );
+				msg += TANGO642_BLK_SIZE;
+				msglen -= TANGO642_BLK_SIZE;
+			}
+
+		#endif // defined( PRVHASH_SIMD )
+
 			while( msglen >= TANGO642_S * TANGO642_PAR )
 			{
 				SeedF4 ^= TANGO642_FN( &Seed, &lcg, (TANGO642_T*) ( ha + hp ));
@@ -321,39 +686,27 @@ static inline void tango642_xor( TANGO642_CTX* const ctx, void* const msg0,
 
 		while( 1 )
 		{
-			size_t rl = ctx -> RndLeft[ p ];
+			const size_t rl = ctx -> RndLeft[ p ];
 
 			if( msglen < rl )
 			{
 				if( msglen != 0 )
 				{
-					TANGO642_T RndBytes = ctx -> RndBytes[ p ];
-					ctx -> RndLeft[ p ] = rl - msglen;
-
-					do
-					{
-						*msg ^= (uint8_t) RndBytes;
-						RndBytes >>= 8;
-						msg++;
-					} while( --msglen != 0 );
+					const TANGO642_T RndBytes = ctx -> RndBytes[ p ];
+					tango642_xor_part( msg, RndBytes, msglen );
 
-					ctx -> RndBytes[ p ] = RndBytes;
+					ctx -> RndBytes[ p ] = RndBytes >> ( msglen * 8 );
+					ctx -> RndLeft[ p ] = rl - msglen;
 				}
 
 				ctx -> RndPos = p;
 				return;
 			}
 
-			TANGO642_T RndBytes = ctx -> RndBytes[ p ];
+			tango642_xor_part( msg, ctx -> RndBytes[ p ], rl );
+			msg += rl;
 			msglen -= rl;
 
-			do
-			{
-				*msg ^= (uint8_t) RndBytes;
-				RndBytes >>= 8;
-				msg++;
-			} while( --rl != 0 );
-
 			if( ++p == TANGO642_PAR )
 			{
 				ctx -> RndPos = p;
@@ -363,6 +716,463 @@ static inline void tango642_xor( TANGO642_CTX* const ctx, void* const msg0,
 	}
 }
 
+/**
+ * An auxiliary function that XORs the specified message with the leftover
+ * random output of the context, produced by a previous tango642_xor() call.
+ *
+ * @param[in,out] ctx Pointer to the context structure.
+ * @param[in,out] msg Message, address alignment is unimportant.
+ * @param msglen Message length, in bytes, can be zero.
+ * @return The number of message bytes XORed. If it is less than "msglen",
+ * the leftover random output was exhausted, and the context's keystream
+ * continues from the keyed and firewalling PRNG state.
+ */
+
+static inline size_t tango642_xor_left( TANGO642_CTX* const ctx,
+	uint8_t* const msg, const size_t msglen )
+{
+	size_t p = ctx -> RndPos;
+	size_t c = 0;
+
+	while( p != TANGO642_PAR )
+	{
+		const size_t rl = ctx -> RndLeft[ p ];
+
+		if( msglen - c < rl )
+		{
+			if( msglen != c )
+			{
+				const TANGO642_T RndBytes = ctx -> RndBytes[ p ];
+				tango642_xor_part( msg + c, RndBytes, msglen - c );
+
+				ctx -> RndBytes[ p ] = RndBytes >> (( msglen - c ) * 8 );
+				ctx -> RndLeft[ p ] = rl - ( msglen - c );
+			}
+
+			ctx -> RndPos = p;
+
+			return( msglen );
+		}
+
+		tango642_xor_part( msg + c, ctx -> RndBytes[ p ], rl );
+		c += rl;
+		p++;
+	}
+
+	ctx -> RndPos = TANGO642_PAR;
+
+	return( c );
+}
+
+#if defined( PRVHASH_SIMD_AVX512 ) || defined( PRVHASH_SIMD_AVX2 )
+
+#define TANGO642_MB_MIN ( TANGO642_S * TANGO642_PAR * 8 ) // Minimal message
+	// length for multi-buffer processing, in bytes; shorter messages are
+	// processed by the tango642_xor() function.
+
+#if defined( PRVHASH_SIMD_AVX512 )
+	#define TANGO642_MB_LANES 8 // The number of messages in lockstep.
+#else // defined( PRVHASH_SIMD_AVX512 )
+	#define TANGO642_MB_LANES 4 // The number of messages in lockstep.
+#endif // defined( PRVHASH_SIMD_AVX512 )
+
+/**
+ * State of TANGO642_MB_LANES "tango642" XOR sessions, used by the
+ * tango642_xor_mb() function, in structure-of-arrays order: element "i" of
+ * each array belongs to lane "i". Lanes' keyed PRNG hash arrays are stored
+ * rotated, so that all lanes use the same hash word position.
+ */
+
+typedef struct
+{
+	TANGO642_T Seed[ TANGO642_MB_LANES ]; ///< Keyed PRNG Seed values.
+	TANGO642_T lcg[ TANGO642_MB_LANES ]; ///< Keyed PRNG lcg values.
+	/// Keyed PRNG hash values.
+	TANGO642_T Hash[ TANGO642_HASH_COUNT ][ TANGO642_MB_LANES ];
+	/// Firewalling PRNG Seed values.
+	TANGO642_T SeedF[ TANGO642_PAR ][ TANGO642_MB_LANES ];
+	/// Firewalling PRNG lcg values.
+	TANGO642_T lcgF[ TANGO642_PAR ][ TANGO642_MB_LANES ];
+	/// Firewalling PRNG hash values.
+	TANGO642_T HashF[ TANGO642_PAR + 1 ][ TANGO642_MB_LANES ];
+	size_t HashOfs[ TANGO642_MB_LANES ]; ///< Lanes' hash word offsets.
+	size_t HashPos; ///< Common hash word position.
+} TANGO642_MB_CTX;
+
+/**
+ * An auxiliary function that moves the state of the XOR session to the
+ * specified lane. The leftover random output should be exhausted.
+ *
+ * @param[in,out] mb Pointer to the multi-buffer state.
+ * @param i Lane's index.
+ * @param ctx Pointer to the context structure.
+ */
+
+static inline void tango642_mb_load( TANGO642_MB_CTX* const mb,
+	const int i, const TANGO642_CTX* const ctx )
+{
+	const size_t o = ( ctx -> HashPos / TANGO642_S - mb -> HashPos ) &
+		( TANGO642_HASH_COUNT - 1 );
+
+	size_t j;
+
+	mb -> Seed[ i ] = ctx -> Seed;
+	mb -> lcg[ i ] = ctx -> lcg;
+	mb -> HashOfs[ i ] = o;
+
+	for( j = 0; j < TANGO642_HASH_COUNT; j++ )
+	{
+		mb -> Hash[ j ][ i ] =
+			ctx -> Hash[ ( j + o ) & ( TANGO642_HASH_COUNT - 1 )];
+	}
+
+	for( j = 0; j < TANGO642_PAR; j++ )
+	{
+		mb -> SeedF[ j ][ i ] = ctx -> SeedF[ j ];
+		mb -> lcgF[ j ][ i ] = ctx -> lcgF[ j ];
+	}
+
+	for( j = 0; j <= TANGO642_PAR; j++ )
+	{
+		mb -> HashF[ j ][ i ] = ctx -> HashF[ j ];
+	}
+}
+
+/**
+ * An auxiliary function that moves the state of the specified lane back to
+ * the context structure.
+ *
+ * @param[in,out] mb Pointer to the multi-buffer state; lane's state is
+ * zeroed.
+ * @param i Lane's index.
+ * @param[out] ctx Pointer to the context structure.
+ */
+
+static inline void tango642_mb_store( TANGO642_MB_CTX* const mb,
+	const int i, TANGO642_CTX* const ctx )
+{
+	const size_t o = mb -> HashOfs[ i ];
+	size_t j;
+
+	ctx -> Seed = mb -> Seed[ i ];
+	ctx -> lcg = mb -> lcg[ i ];
+	ctx -> HashPos = (( mb -> HashPos + o ) &
+		( TANGO642_HASH_COUNT - 1 )) * TANGO642_S;
+
+	for( j = 0; j < TANGO642_HASH_COUNT; j++ )
+	{
+		ctx -> Hash[ ( j + o ) & ( TANGO642_HASH_COUNT - 1 )] =
+			mb -> Hash[ j ][ i ];
+
+		mb -> Hash[ j ][ i ] = 0;
+	}
+
+	for( j = 0; j < TANGO642_PAR; j++ )
+	{
+		ctx -> SeedF[ j ] = mb -> SeedF[ j ][ i ];
+		ctx -> lcgF[ j ] = mb -> lcgF[ j ][ i ];
+	}
+
+	for( j = 0; j <= TANGO642_PAR; j++ )
+	{
+		ctx -> HashF[ j ] = mb -> HashF[ j ][ i ];
+	}
+
+	mb -> Seed[ i ] = 0;
+	mb -> lcg[ i ] = 0;
+}
+
+/**
+ * An auxiliary function that XORs TANGO642_MB_LANES messages, "n" iterations
+ * of TANGO642_S * TANGO642_PAR bytes each, with keystreams of the lanes,
+ * using vector PRVHASH core functions.
+ *
+ * @param[in,out] mb Pointer to the multi-buffer state.
+ * @param[in,out] msg Message pointers, TANGO642_MB_LANES items, advanced.
+ * @param n The number of iterations.
+ */
+
+static inline void tango642_mb_xor( TANGO642_MB_CTX* const mb,
+	uint8_t** const msg, size_t n )
+{
+	#if defined( PRVHASH_SIMD_AVX512 )
+		#define TANGO642_MB_V __m512i
+		#define TANGO642_MB_LD( v ) _mm512_loadu_si512( (const void*) ( v ))
+		#define TANGO642_MB_ST( v, x ) _mm512_storeu_si512( (void*) ( v ), x )
+		#define TANGO642_MB_XOR( x, y ) _mm512_xor_si512( x, y )
+		#define TANGO642_MB_FN prvhash_core64_v8
+	#else // defined( PRVHASH_SIMD_AVX512 )
+		#define TANGO642_MB_V __m256i
+		#define TANGO642_MB_LD( v ) _mm256_loadu_si256( (const __m256i*) ( v ))
+		#define TANGO642_MB_ST( v, x ) \
+			_mm256_storeu_si256( (__m256i*) ( v ), x )
+		#define TANGO642_MB_XOR( x, y ) _mm256_xor_si256( x, y )
+		#define TANGO642_MB_FN prvhash_core64_v4
+	#endif // defined( PRVHASH_SIMD_AVX512 )
+
+	#define TANGO642_MB_SH( v1, v2, v3, v4, v5 ) \
+		{ TANGO642_MB_V t = v1; v1 = v2; v2 = v3; v3 = v4; v4 = v5; v5 = t; }
+
+	// XORs 32 message bytes with 32 keystream bytes.
+
+	#define TANGO642_MB_XM( m, k ) \
+		_mm256_storeu_si256( (__m256i*) ( m ), _mm256_xor_si256( \
+			_mm256_loadu_si256( (const __m256i*) ( m )), k ))
+
+	TANGO642_MB_V Seed = TANGO642_MB_LD( mb -> Seed );
+	TANGO642_MB_V lcg = TANGO642_MB_LD( mb -> lcg );
+	TANGO642_MB_V SeedF1 = TANGO642_MB_LD( mb -> SeedF[ 0 ]);
+	TANGO642_MB_V SeedF2 = TANGO642_MB_LD( mb -> SeedF[ 1 ]);
+	TANGO642_MB_V SeedF3 = TANGO642_MB_LD( mb -> SeedF[ 2 ]);
+	TANGO642_MB_V SeedF4 = TANGO642_MB_LD( mb -> SeedF[ 3 ]);
+	TANGO642_MB_V lcgF1 = TANGO642_MB_LD( mb -> lcgF[ 0 ]);
+	TANGO642_MB_V lcgF2 = TANGO642_MB_LD( mb -> lcgF[ 1 ]);
+	TANGO642_MB_V lcgF3 = TANGO642_MB_LD( mb -> lcgF[ 2 ]);
+	TANGO642_MB_V lcgF4 = TANGO642_MB_LD( mb -> lcgF[ 3 ]);
+	TANGO642_MB_V HashF1 = TANGO642_MB_LD( mb -> HashF[ 0 ]);
+	TANGO642_MB_V HashF2 = TANGO642_MB_LD( mb -> HashF[ 1 ]);
+	TANGO642_MB_V HashF3 = TANGO642_MB_LD( mb -> HashF[ 2 ]);
+	TANGO642_MB_V HashF4 = TANGO642_MB_LD( mb -> HashF[ 3 ]);
+	TANGO642_MB_V HashF5 = TANGO642_MB_LD( mb -> HashF[ 4 ]);
+	uint8_t* m[ TANGO642_MB_LANES ];
+	size_t hp = mb -> HashPos;
+	size_t o = 0; // Common message offset.
+	int i;
+
+	for( i = 0; i < TANGO642_MB_LANES; i++ )
+	{
+		m[ i ] = msg[ i ];
+	}
+
+	#if defined( PRVHASH_SIMD_AVX512 )
+
+	// Permutation indices that gather keystreams of lanes 0 and 2 (4 and 6,
+	// respectively) out of unpacked outputs.
+
+	const __m512i pl = _mm512_set_epi64( 11, 10, 3, 2, 9, 8, 1, 0 );
+	const __m512i ph = _mm512_set_epi64( 15, 14, 7, 6, 13, 12, 5, 4 );
+
+	#endif // defined( PRVHASH_SIMD_AVX512 )
+
+	while( n != 0 )
+	{
+		TANGO642_MB_V h = TANGO642_MB_LD( mb -> Hash[ hp ]);
+
+		SeedF4 = TANGO642_MB_XOR( SeedF4, TANGO642_MB_FN( &Seed, &lcg, &h ));
+
+		TANGO642_MB_ST( mb -> Hash[ hp ], h );
+		hp = ( hp + 1 ) & ( TANGO642_HASH_COUNT - 1 );
+
+		const TANGO642_MB_V o1 = TANGO642_MB_FN( &SeedF1, &lcgF1, &HashF1 );
+		const TANGO642_MB_V o2 = TANGO642_MB_FN( &SeedF2, &lcgF2, &HashF2 );
+		const TANGO642_MB_V o3 = TANGO642_MB_FN( &SeedF3, &lcgF3, &HashF3 );
+		const TANGO642_MB_V o4 = TANGO642_MB_FN( &SeedF4, &lcgF4, &HashF4 );
+
+		TANGO642_MB_SH( HashF1, HashF2, HashF3, HashF4, HashF5 );
+
+		// Transpose outputs into lanes' keystreams.
+
+	#if defined( PRVHASH_SIMD_AVX512 )
+
+		const __m512i t1 = _mm512_unpacklo_epi64( o1, o2 );
+		const __m512i t2 = _mm512_unpackhi_epi64( o1, o2 );
+		const __m512i t3 = _mm512_unpacklo_epi64( o3, o4 );
+		const __m512i t4 = _mm512_unpackhi_epi64( o3, o4 );
+		const __m512i k02 = _mm512_permutex2var_epi64( t1, pl, t3 );
+		const __m512i k13 = _mm512_permutex2var_epi64( t2, pl, t4 );
+		const __m512i k46 = _mm512_permutex2var_epi64( t1, ph, t3 );
+		const __m512i k57 = _mm512_permutex2var_epi64( t2, ph, t4 );
+
+		TANGO642_MB_XM( m[ 0 ] + o, _mm512_castsi512_si256( k02 ));
+		TANGO642_MB_XM( m[ 1 ] + o, _mm512_castsi512_si256( k13 ));
+		TANGO642_MB_XM( m[ 2 ] + o, _mm512_extracti64x4_epi64( k02, 1 ));
+		TANGO642_MB_XM( m[ 3 ] + o, _mm512_extracti64x4_epi64( k13, 1 ));
+		TANGO642_MB_XM( m[ 4 ] + o, _mm512_castsi512_si256( k46 ));
+		TANGO642_MB_XM( m[ 5 ] + o, _mm512_castsi512_si256( k57 ));
+		TANGO642_MB_XM( m[ 6 ] + o, _mm512_extracti64x4_epi64( k46, 1 ));
+		TANGO642_MB_XM( m[ 7 ] + o, _mm512_extracti64x4_epi64( k57, 1 ));
+
+	#else // defined( PRVHASH_SIMD_AVX512 )
+
+		const __m256i t1 = _mm256_unpacklo_epi64( o1, o2 );
+		const __m256i t2 = _mm256_unpackhi_epi64( o1, o2 );
+		const __m256i t3 = _mm256_unpacklo_epi64( o3, o4 );
+		const __m256i t4 = _mm256_unpackhi_epi64( o3, o4 );
+
+		TANGO642_MB_XM( m[ 0 ] + o, _mm256_permute2x128_si256( t1, t3, 0x20 ));
+		TANGO642_MB_XM( m[ 1 ] + o, _mm256_permute2x128_si256( t2, t4, 0x20 ));
+		TANGO642_MB_XM( m[ 2 ] + o, _mm256_permute2x128_si256( t1, t3, 0x31 ));
+		TANGO642_MB_XM( m[ 3 ] + o, _mm256_permute2x128_si256( t2, t4, 0x31 ));
+
+	#endif // defined( PRVHASH_SIMD_AVX512 )
+
+		o += TANGO642_S * TANGO642_PAR;
+		n--;
+	}
+
+	TANGO642_MB_ST( mb -> Seed, Seed );
+	TANGO642_MB_ST( mb -> lcg, lcg );
+	TANGO642_MB_ST( mb -> SeedF[ 0 ], SeedF1 );
+	TANGO642_MB_ST( mb -> SeedF[ 1 ], SeedF2 );
+	TANGO642_MB_ST( mb -> SeedF[ 2 ], SeedF3 );
+	TANGO642_MB_ST( mb -> SeedF[ 3 ], SeedF4 );
+	TANGO642_MB_ST( mb -> lcgF[ 0 ], lcgF1 );
+	TANGO642_MB_ST( mb -> lcgF[ 1 ], lcgF2 );
+	TANGO642_MB_ST( mb -> lcgF[ 2 ], lcgF3 );
+	TANGO642_MB_ST( mb -> lcgF[ 3 ], lcgF4 );
+	TANGO642_MB_ST( mb -> HashF[ 0 ], HashF1 );
+	TANGO642_MB_ST( mb -> HashF[ 1 ], HashF2 );
+	TANGO642_MB_ST( mb -> HashF[ 2 ], HashF3 );
+	TANGO642_MB_ST( mb -> HashF[ 3 ], HashF4 );
+	TANGO642_MB_ST( mb -> HashF[ 4 ], HashF5 );
+
+	for( i = 0; i < TANGO642_MB_LANES; i++ )
+	{
+		msg[ i ] = m[ i ] + o;
+	}
+
+	mb -> HashPos = hp;
+
+	#undef TANGO642_MB_V
+	#undef TANGO642_MB_LD
+	#undef TANGO642_MB_ST
+	#undef TANGO642_MB_XOR
+	#undef TANGO642_MB_FN
+	#undef TANGO642_MB_SH
+	#undef TANGO642_MB_XM
+}
+
+#endif // defined( PRVHASH_SIMD_AVX512 ) || defined( PRVHASH_SIMD_AVX2 )
+
+/**
+ * Multi-buffer variant of the tango642_xor() function, which applies XOR
+ * operation over several messages, each with its own context structure.
+ * With AVX2 instructions, 4 messages are processed in lockstep, using vector
+ * PRVHASH core functions, and 8 messages with AVX-512 instructions
+ * (TANGO642_MB_LANES); a message that has been processed is replaced with
+ * the next message. This increases throughput on many messages
+ * of moderate length; messages shorter than TANGO642_MB_MIN are processed
+ * one by one, as lockstep does not benefit them. On other systems, messages
+ * are processed one by one. The output is equal to the output of the
+ * tango642_xor() function called for each message; the context structures
+ * can be used with the tango642_xor() function afterwards.
+ *
+ * @param ctxs Pointers to context structures, "count" items, initialized by
+ * the tango642_init() function. Pointers should be distinct.
+ * @param msgs Pointers to message buffers, "count" items, address alignment
+ * is unimportant.
+ * @param msglens Message lengths, in bytes, "count" items, can be zero.
+ * @param count The number of messages.
+ */
+
+static inline void tango642_xor_mb( TANGO642_CTX* const* const ctxs,
+	void* const* const msgs, const size_t* const msglens, const size_t count )
+{
+#if defined( PRVHASH_SIMD_AVX512 ) || defined( PRVHASH_SIMD_AVX2 )
+
+	TANGO642_MB_CTX mb;
+	TANGO642_CTX* lc[ TANGO642_MB_LANES ]; // Lane contexts, 0 - free lane.
+	uint8_t* lm[ TANGO642_MB_LANES ]; // Lane message pointers.
+	size_t ln[ TANGO642_MB_LANES ]; // Lane iterations left.
+	size_t lt[ TANGO642_MB_LANES ]; // Lane message tail lengths.
+	size_t k = 0; // The next message.
+	int i;
+
+	for( i = 0; i < TANGO642_MB_LANES; i++ )
+	{
+		lc[ i ] = 0;
+	}
+
+	mb.HashPos = 0;
+
+	while( 1 )
+	{
+		// Fill free lanes with the next long messages.
+
+		int lanes = 0;
+
+		for( i = 0; i < TANGO642_MB_LANES; i++ )
+		{
+			while( lc[ i ] == 0 && k < count )
+			{
+				TANGO642_CTX* const ctx = ctxs[ k ];
+				uint8_t* msg = (uint8_t*) msgs[ k ];
+				size_t msglen = msglens[ k ];
+				k++;
+
+				const size_t c = tango642_xor_left( ctx, msg, msglen );
+				msg += c;
+				msglen -= c;
+
+				if( msglen < TANGO642_MB_MIN )
+				{
+					tango642_xor( ctx, msg, msglen );
+					continue;
+				}
+
+				tango642_mb_load( &mb, i, ctx );
+				lc[ i ] = ctx;
+				lm[ i ] = msg;
+				ln[ i ] = msglen / ( TANGO642_S * TANGO642_PAR );
+				lt[ i ] = msglen % ( TANGO642_S * TANGO642_PAR );
+			}
+
+			lanes += ( lc[ i ] != 0 );
+		}
+
+		if( lanes < TANGO642_MB_LANES )
+		{
+			// No more messages: finish the remaining lanes one by one.
+
+			for( i = 0; i < TANGO642_MB_LANES; i++ )
+			{
+				if( lc[ i ] != 0 )
+				{
+					tango642_mb_store( &mb, i, lc[ i ]);
+					tango642_xor( lc[ i ], lm[ i ],
+						ln[ i ] * TANGO642_S * TANGO642_PAR + lt[ i ]);
+				}
+			}
+
+			break;
+		}
+
+		size_t m = ln[ 0 ];
+
+		for( i = 1; i < TANGO642_MB_LANES; i++ )
+		{
+			m = ( ln[ i ] < m ? ln[ i ] : m );
+		}
+
+		tango642_mb_xor( &mb, lm, m );
+
+		for( i = 0; i < TANGO642_MB_LANES; i++ )
+		{
+			ln[ i ] -= m;
+
+			if( ln[ i ] == 0 )
+			{
+				tango642_mb_store( &mb, i, lc[ i ]);
+				tango642_xor( lc[ i ], lm[ i ], lt[ i ]);
+				lc[ i ] = 0;
+			}
+		}
+	}
+
+	memset( &mb, 0, sizeof( mb ));
+
+#else // defined( PRVHASH_SIMD_AVX512 ) || defined( PRVHASH_SIMD_AVX2 )
+
+	size_t k;
+
+	for( k = 0; k < count; k++ )
+	{
+		tango642_xor( ctxs[ k ], msgs[ k ], msglens[ k ]);
+	}
+
+#endif // defined( PRVHASH_SIMD_AVX512 ) || defined( PRVHASH_SIMD_AVX2 )
+}
+
 /**
  * Function finalizes the XOR session.
  *
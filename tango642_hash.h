@@ -0,0 +1,351 @@
+/**
+ * tango642_hash.h version 4.3.0
+ *
+ * The inclusion file for the "tango642_hash" functions that fuse the
+ * "tango642" XOR function with the "prvhash64s" hashing of the ciphertext,
+ * for encrypt-then-hash (and hash-then-decrypt) operation in a single pass
+ * over memory. The message is processed in cache-sized tiles: each tile is
+ * hashed while it still resides in the processor's cache. Results are equal
+ * to the separate XOR and hashing passes.
+ *
+ * Description is available at https://github.com/avaneev/prvhash
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TANGO642_HASH_INCLUDED
+#define TANGO642_HASH_INCLUDED
+
+#include "tango642s.h"
+#include "prvhash64s_tree.h"
+
+#define TANGO642H_TILE 16384 // Tile length, in bytes, fits the L1 cache.
+
+/**
+ * The context structure of the "tango642h_X" streaming functions. On systems
+ * where this is relevant, this structure should be aligned to 8 bytes.
+ */
+
+typedef struct {
+	TANGO642_CTX Xor; ///< XOR session.
+	PRVHASH64S_CTX Hash; ///< Ciphertext's hashing session.
+} TANGO642H_CTX;
+
+/**
+ * Function initializes the fused XOR and hashing session.
+ *
+ * @param[out] ctx Pointer to the context structure. Should be aligned to
+ * 8 bytes.
+ * @param key0 Uniformly-random key buffer, see the tango642_init() function
+ * for details.
+ * @param keylen Length of "key", in bytes.
+ * @param iv0 Initialization vector (nonce), can be 0 if "ivlen" is also 0.
+ * @param ivlen Length of "iv", in bytes.
+ * @param HashLen The required hash length, in bytes; should be >= PRH64S_S,
+ * in increments of PRH64S_S. Should not exceed PRH64S_MAX.
+ * @param UseSeeds Optional pointer to hash's seed entropy pool, see the
+ * prvhash64s_init() function for details; 0 - use the default seeds.
+ */
+
+static inline void tango642h_init( TANGO642H_CTX* const ctx,
+	const void* const key0, const size_t keylen, const void* const iv0,
+	const size_t ivlen, const size_t HashLen, const void* const UseSeeds )
+{
+	tango642_init( &ctx -> Xor, key0, keylen, iv0, ivlen );
+	prvhash64s_init( &ctx -> Hash, HashLen, UseSeeds );
+}
+
+/**
+ * This function encrypts the specified "message" buffer in-place, and
+ * updates the hash with the resulting ciphertext. The result is equal to
+ * the tango642_xor() call followed by the prvhash64s_update() call over the
+ * same buffer.
+ *
+ * @param[in,out] ctx Pointer to the context structure.
+ * @param[in,out] msg0 Message buffer, address alignment is unimportant,
+ * can be zero if msglen is zero.
+ * @param msglen Message length, in bytes, can be zero.
+ */
+
+static inline void tango642h_encrypt( TANGO642H_CTX* const ctx,
+	void* const msg0, size_t msglen )
+{
+	uint8_t* msg = (uint8_t*) msg0;
+
+	while( msglen != 0 )
+	{
+		const size_t l = ( msglen > TANGO642H_TILE ? TANGO642H_TILE : msglen );
+
+		tango642_xor( &ctx -> Xor, msg, l );
+		prvhash64s_update( &ctx -> Hash, msg, l );
+
+		msg += l;
+		msglen -= l;
+	}
+}
+
+/**
+ * This function updates the hash with the specified ciphertext buffer, and
+ * decrypts it in-place. The resulting hash is equal to the hash produced by
+ * the tango642h_encrypt() function for the same plaintext.
+ *
+ * @param[in,out] ctx Pointer to the context structure.
+ * @param[in,out] msg0 Message buffer, address alignment is unimportant,
+ * can be zero if msglen is zero.
+ * @param msglen Message length, in bytes, can be zero.
+ */
+
+static inline void tango642h_decrypt( TANGO642H_CTX* const ctx,
+	void* const msg0, size_t msglen )
+{
+	uint8_t* msg = (uint8_t*) msg0;
+
+	while( msglen != 0 )
+	{
+		const size_t l = ( msglen > TANGO642H_TILE ? TANGO642H_TILE : msglen );
+
+		prvhash64s_update( &ctx -> Hash, msg, l );
+		tango642_xor( &ctx -> Xor, msg, l );
+
+		msg += l;
+		msglen -= l;
+	}
+}
+
+/**
+ * Function finalizes the session and produces the ciphertext's hash.
+ *
+ * @param[in,out] ctx Pointer to the context structure. Zeroed on function's
+ * return.
+ * @param[out] HashOut The hash buffer, length = HashLen. The address
+ * alignment of this buffer is unimportant.
+ */
+
+static inline void tango642h_final( TANGO642H_CTX* const ctx,
+	void* const HashOut )
+{
+	tango642_final( &ctx -> Xor );
+	prvhash64s_final( &ctx -> Hash, HashOut );
+}
+
+/**
+ * An auxiliary function that XORs a chunk via the "tango642s" function, and
+ * produces chunk's leaf digest of the "prvhash64s_tree" hash, tile by tile.
+ *
+ * @param kctx Pointer to the keyed context structure.
+ * @param Decrypt 1 - hash before XOR, 0 - hash after XOR.
+ * @param Index Chunk's index.
+ * @param[in,out] msg Chunk's buffer.
+ * @param l Chunk's length, in bytes, up to PRH64ST_CHUNK.
+ * @param Seeds Hash's seed entropy pool, PRH64ST_SEEDS bytes.
+ * @param HashLen Hash length, in bytes.
+ * @param[out] LeafOut Leaf digest, HashLen bytes.
+ */
+
+static inline void tango642h_chunk( const TANGO642_CTX* const kctx,
+	const int Decrypt, const uint64_t Index, uint8_t* const msg,
+	const size_t l, const uint8_t* const Seeds, const size_t HashLen,
+	uint8_t* const LeafOut )
+{
+	PRVHASH64S_CTX ctx;
+	const uint64_t Offset = Index * PRH64ST_CHUNK;
+	size_t o;
+
+	prvhash64s_tree_sinit( &ctx, HashLen, Seeds, PRH64ST_LEAF, Index );
+
+	for( o = 0; o < l; o += TANGO642H_TILE )
+	{
+		const size_t tl = ( l - o > TANGO642H_TILE ? TANGO642H_TILE : l - o );
+
+		if( Decrypt )
+		{
+			prvhash64s_update( &ctx, msg + o, tl );
+			tango642s_xor( kctx, Offset + o, msg + o, tl );
+		}
+		else
+		{
+			tango642s_xor( kctx, Offset + o, msg + o, tl );
+			prvhash64s_update( &ctx, msg + o, tl );
+		}
+	}
+
+	prvhash64s_final( &ctx, LeafOut );
+}
+
+/**
+ * Chunk job, used by the tango642h_xor_mt() function.
+ */
+
+typedef struct {
+	const TANGO642_CTX* kctx; ///< Keyed context structure.
+	int Decrypt; ///< Hash before XOR.
+	uint8_t* msg; ///< Message buffer.
+	size_t msglen; ///< Message length, in bytes.
+	size_t First; ///< First chunk to process.
+	size_t Count; ///< The number of chunks in the message.
+	size_t Step; ///< Chunk index increment.
+	const uint8_t* Seeds; ///< Hash's seed entropy pool.
+	size_t HashLen; ///< Hash length, in bytes.
+	uint8_t* LeafOut; ///< Leaf digests, Count * HashLen bytes.
+} TANGO642H_JOB;
+
+/**
+ * Thread function that processes chunks of a TANGO642H_JOB job.
+ *
+ * @param arg Pointer to the job structure.
+ */
+
+static PRVHASH_THREAD_RET tango642h_job( void* const arg )
+{
+	const TANGO642H_JOB* const job = (const TANGO642H_JOB*) arg;
+	size_t k;
+
+	for( k = job -> First; k < job -> Count; k += job -> Step )
+	{
+		const size_t o = k * PRH64ST_CHUNK;
+		const size_t l = job -> msglen - o;
+
+		tango642h_chunk( job -> kctx, job -> Decrypt, k, job -> msg + o,
+			( l > PRH64ST_CHUNK ? PRH64ST_CHUNK : l ), job -> Seeds,
+			job -> HashLen, job -> LeafOut + k * job -> HashLen );
+	}
+
+	PRVHASH_THREAD_EXIT;
+}
+
+/**
+ * Multithreaded fused XOR and hashing function. The whole message is XORed
+ * in-place via the "tango642s" seekable function, and its ciphertext is
+ * hashed with the "prvhash64s_tree" hash function, chunk by chunk: chunks
+ * are interleaved between threads, each chunk is XORed and hashed in tiles.
+ * The result is equal to the tango642s_xor() call at zero offset, and the
+ * "prvhash64s_tree" hashing of the ciphertext. Falls back to the calling
+ * thread if threads or memory are unavailable.
+ *
+ * @param kctx Pointer to the keyed context structure, initialized by the
+ * tango642_init() function, and not used by the tango642_xor() function.
+ * @param Decrypt 0 - encrypt the message, 1 - decrypt the message; the hash
+ * is always calculated over the ciphertext.
+ * @param[in,out] msg0 Message buffer, address alignment is unimportant,
+ * can be zero if msglen is zero.
+ * @param msglen Message length, in bytes, can be zero.
+ * @param[out] HashOut The hash buffer, length = HashLen. The address
+ * alignment of this buffer is unimportant.
+ * @param HashLen The required hash length, in bytes; should be >= PRH64S_S,
+ * in increments of PRH64S_S. Should not exceed PRH64S_MAX.
+ * @param UseSeeds Optional pointer to hash's seed entropy pool,
+ * PRH64ST_SEEDS bytes; 0 - use the default seeds.
+ * @param ThreadCount The number of threads to use; 0 - use the number of
+ * processor cores.
+ */
+
+static inline void tango642h_xor_mt( const TANGO642_CTX* const kctx,
+	const int Decrypt, void* const msg0, const size_t msglen,
+	void* const HashOut, const size_t HashLen, const void* const UseSeeds,
+	int ThreadCount )
+{
+	uint8_t* const msg = (uint8_t*) msg0;
+	uint8_t Seeds[ PRH64ST_SEEDS ];
+	PRVHASH64S_CTX Root;
+
+	if( UseSeeds == 0 )
+	{
+		memset( Seeds, 0, PRH64ST_SEEDS );
+	}
+	else
+	{
+		memcpy( Seeds, UseSeeds, PRH64ST_SEEDS );
+	}
+
+	prvhash64s_tree_sinit( &Root, HashLen, Seeds, PRH64ST_ROOT, 0 );
+
+	// An empty message still produces a single (empty) leaf.
+
+	const size_t Count = ( msglen == 0 ? 1 :
+		( msglen - 1 ) / PRH64ST_CHUNK + 1 );
+
+	if( ThreadCount <= 0 )
+	{
+		ThreadCount = prvhash_thread_count();
+	}
+
+	if( ThreadCount > PRVHASH_THREAD_MAX )
+	{
+		ThreadCount = PRVHASH_THREAD_MAX;
+	}
+
+	if( (size_t) ThreadCount > Count )
+	{
+		ThreadCount = (int) Count;
+	}
+
+	uint8_t* const LeafOut = ( ThreadCount < 2 ? 0 :
+		(uint8_t*) malloc( Count * HashLen ));
+
+	if( LeafOut == 0 )
+	{
+		uint8_t h[ PRH64S_MAX ];
+		size_t k;
+
+		for( k = 0; k < Count; k++ )
+		{
+			const size_t l = msglen - k * PRH64ST_CHUNK;
+
+			tango642h_chunk( kctx, Decrypt, k, msg + k * PRH64ST_CHUNK,
+				( l > PRH64ST_CHUNK ? PRH64ST_CHUNK : l ), Seeds, HashLen, h );
+
+			prvhash64s_update( &Root, h, HashLen );
+		}
+
+		prvhash64s_final( &Root, HashOut );
+		memset( h, 0, sizeof( h ));
+
+		return;
+	}
+
+	TANGO642H_JOB jobs[ PRVHASH_THREAD_MAX ];
+	int i;
+
+	for( i = 0; i < ThreadCount; i++ )
+	{
+		jobs[ i ].kctx = kctx;
+		jobs[ i ].Decrypt = Decrypt;
+		jobs[ i ].msg = msg;
+		jobs[ i ].msglen = msglen;
+		jobs[ i ].First = (size_t) i;
+		jobs[ i ].Count = Count;
+		jobs[ i ].Step = (size_t) ThreadCount;
+		jobs[ i ].Seeds = Seeds;
+		jobs[ i ].HashLen = HashLen;
+		jobs[ i ].LeafOut = LeafOut;
+	}
+
+	prvhash_thread_run( tango642h_job, jobs, sizeof( jobs[ 0 ]), ThreadCount );
+
+	prvhash64s_update( &Root, LeafOut, Count * HashLen );
+	prvhash64s_final( &Root, HashOut );
+
+	free( LeafOut );
+}
+
+#endif // TANGO642_HASH_INCLUDED
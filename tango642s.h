@@ -0,0 +1,228 @@
+/**
+ * tango642s.h version 4.3.9
+ *
+ * The inclusion file for the "tango642s" seekable variant of the "tango642"
+ * PRVHASH PRNG-based XOR function. The message is split into blocks, with
+ * each block XORed with an independent firewalled PRNG keystream derived
+ * from the keyed PRNG state and block's index. This allows random access to
+ * the message, and multithreaded operation. Note that this variant produces
+ * a keystream that is different to the "tango642" keystream.
+ *
+ * Description is available at https://github.com/avaneev/prvhash
+ *
+ * License
+ *
+ * Copyright (c) 2020-2023 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TANGO642S_INCLUDED
+#define TANGO642S_INCLUDED
+
+#include "tango642.h"
+#include "prvhash_thread.h"
+
+#define TANGO642S_BLK 4096 // Block length, in bytes.
+#define TANGO642S_MT_BLKS 64 // Minimal number of blocks per thread.
+
+/**
+ * Function initializes the context structure for XOR of the specified
+ * block. This structure can be then used with the tango642_xor() function,
+ * starting at block's start, for up to TANGO642S_BLK bytes. After the use,
+ * the tango642_final() function should be called on this structure.
+ *
+ * @param[out] ctx Pointer to block's context structure.
+ * @param kctx Pointer to the keyed context structure, initialized by the
+ * tango642_init() function, and not used by the tango642_xor() function.
+ * @param BlockIndex Block's index.
+ */
+
+static inline void tango642s_block_init( TANGO642_CTX* const ctx,
+	const TANGO642_CTX* const kctx, const uint64_t BlockIndex )
+{
+	// Input block's index as a little-endian 8-byte "iv", with the same
+	// absorption and elimination passes as used by the tango642_init()
+	// function.
+
+	uint8_t iv[ 8 ];
+	int i;
+
+	for( i = 0; i < 8; i++ )
+	{
+		iv[ i ] = (uint8_t) ( BlockIndex >> ( i * 8 ));
+	}
+
+	tango642_init_iv( ctx, kctx, iv, sizeof( iv ));
+}
+
+/**
+ * This function applies XOR operation over the specified "message" buffer,
+ * located at the specified offset within the whole message. Encryption and
+ * decryption of any part of the message can be performed in any order.
+ *
+ * @param kctx Pointer to the keyed context structure, initialized by the
+ * tango642_init() function, and not used by the tango642_xor() function.
+ * @param Offset Offset of the "message" buffer within the whole message, in
+ * bytes.
+ * @param[in,out] msg0 Message buffer, address alignment is unimportant,
+ * can be zero if msglen is zero.
+ * @param msglen Message length, in bytes, can be zero.
+ */
+
+static inline void tango642s_xor( const TANGO642_CTX* const kctx,
+	uint64_t Offset, void* const msg0, size_t msglen )
+{
+	uint8_t* msg = (uint8_t*) msg0;
+	TANGO642_CTX ctx;
+
+	while( msglen != 0 )
+	{
+		tango642s_block_init( &ctx, kctx, Offset / TANGO642S_BLK );
+
+		size_t o = (size_t) ( Offset % TANGO642S_BLK );
+		size_t l = TANGO642S_BLK - o;
+
+		if( l > msglen )
+		{
+			l = msglen;
+		}
+
+		Offset += l;
+		msglen -= l;
+
+		// Skip keystream located before the buffer's start.
+
+		if( o != 0 )
+		{
+			uint8_t pad[ 256 ];
+			memset( pad, 0, sizeof( pad ));
+
+			while( o != 0 )
+			{
+				const size_t sl = ( o > sizeof( pad ) ? sizeof( pad ) : o );
+				tango642_xor( &ctx, pad, sl );
+				o -= sl;
+			}
+
+			memset( pad, 0, sizeof( pad ));
+		}
+
+		tango642_xor( &ctx, msg, l );
+		msg += l;
+	}
+
+	tango642_final( &ctx );
+}
+
+/**
+ * XOR job, used by the tango642s_xor_mt() function.
+ */
+
+typedef struct {
+	const TANGO642_CTX* kctx; ///< Keyed context structure.
+	uint64_t Offset; ///< Offset of the message buffer.
+	uint8_t* msg; ///< Message buffer.
+	size_t msglen; ///< Message length, in bytes.
+} TANGO642S_JOB;
+
+/**
+ * Thread function that performs a TANGO642S_JOB job.
+ *
+ * @param arg Pointer to the job structure.
+ */
+
+static PRVHASH_THREAD_RET tango642s_job( void* const arg )
+{
+	const TANGO642S_JOB* const job = (const TANGO642S_JOB*) arg;
+
+	tango642s_xor( job -> kctx, job -> Offset, job -> msg, job -> msglen );
+
+	PRVHASH_THREAD_EXIT;
+}
+
+/**
+ * Multithreaded variant of the tango642s_xor() function that distributes
+ * contiguous ranges of blocks between threads; it produces results that are
+ * equal to the tango642s_xor() function. Falls back to the calling thread if
+ * threads are unavailable, or if the message is short.
+ *
+ * @param kctx Pointer to the keyed context structure, initialized by the
+ * tango642_init() function, and not used by the tango642_xor() function.
+ * @param Offset Offset of the "message" buffer within the whole message, in
+ * bytes.
+ * @param[in,out] msg0 Message buffer, address alignment is unimportant,
+ * can be zero if msglen is zero.
+ * @param msglen Message length, in bytes, can be zero.
+ * @param ThreadCount The number of threads to use; 0 - use the number of
+ * processor cores.
+ */
+
+static inline void tango642s_xor_mt( const TANGO642_CTX* const kctx,
+	const uint64_t Offset, void* const msg0, const size_t msglen,
+	int ThreadCount )
+{
+	uint8_t* const msg = (uint8_t*) msg0;
+	const uint64_t bs = Offset / TANGO642S_BLK;
+	const uint64_t Count = ( msglen == 0 ? 0 :
+		( Offset + msglen - 1 ) / TANGO642S_BLK - bs + 1 );
+
+	if( ThreadCount <= 0 )
+	{
+		ThreadCount = prvhash_thread_count();
+	}
+
+	if( ThreadCount > PRVHASH_THREAD_MAX )
+	{
+		ThreadCount = PRVHASH_THREAD_MAX;
+	}
+
+	if( (uint64_t) ThreadCount > Count / TANGO642S_MT_BLKS )
+	{
+		ThreadCount = (int) ( Count / TANGO642S_MT_BLKS );
+	}
+
+	if( ThreadCount < 2 )
+	{
+		tango642s_xor( kctx, Offset, msg, msglen );
+		return;
+	}
+
+	TANGO642S_JOB jobs[ PRVHASH_THREAD_MAX ];
+	uint64_t o = Offset;
+	int i;
+
+	for( i = 0; i < ThreadCount; i++ )
+	{
+		// Thread's range ends at a block boundary, except the last one.
+
+		const uint64_t e = ( i == ThreadCount - 1 ? Offset + msglen :
+			( bs + Count * ( i + 1 ) / ThreadCount ) * TANGO642S_BLK );
+
+		jobs[ i ].kctx = kctx;
+		jobs[ i ].Offset = o;
+		jobs[ i ].msg = msg + ( o - Offset );
+		jobs[ i ].msglen = (size_t) ( e - o );
+		o = e;
+	}
+
+	prvhash_thread_run( tango642s_job, jobs, sizeof( jobs[ 0 ]), ThreadCount );
+}
+
+#endif // TANGO642S_INCLUDED